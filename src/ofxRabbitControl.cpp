@@ -37,706 +37,200 @@
 
 #include "rabbitControl/parameter_intern.h"
 
-int16_t ofxRabbitControlServer::findParam(void* paramAdr) {
+#include "ofUtils.h"
 
-    auto it = paramIdMap.find(paramAdr);
-    if (it != paramIdMap.end()) {
-        // found
-        return it->second;
-    }
-
-    return 0;
-}
-
-
-//----------------------------------------------------
-//----------------------------------------------------
-// group
-//----------------------------------------------------
-//----------------------------------------------------
-rcp::GroupParameterPtr ofxRabbitControlServer::expose(ofParameterGroup& group, const rcp::GroupParameterPtr& rabbitgroup) {
-
-    auto it = groupIdMap.find((void*)&group);
-    if (it != groupIdMap.end()) {
-        // already exposed - return parameter
-        return std::dynamic_pointer_cast<rcp::GroupParameter>(ParameterServer::getParameter(it->second));
-    }
-
-    rcp::GroupParameterPtr gp;
-    if (rabbitgroup) {
-        gp = ParameterServer::createGroupParameter(group.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    } else {
-        gp = ParameterServer::createGroupParameter(group.getName());
-    }
-
-    std::size_t s = group.size();
-    for (std::size_t i = 0; i < group.size(); i++) {
-
-        std::string t = group[i].valueType();
-
-        if (t == "a" || t == "c") {
-            auto& p = group.getChar(group[i].getName());
-            expose(p, gp);
-        } else if (t == "h") {
-            // uint8, usigned char
-            ofLogNotice() << "unhandled uint8\n";
-        } else if (t == "s") {
-            // short
-            ofLogNotice() << "unhandled short\n";
-        } else if (t == "t") {
-            // unsigned short
-            ofLogNotice() << "unhandled unsigned short\n";
-        } else if (t == "i") {
-            auto& p = group.getInt(group[i].getName());
-            expose(p, gp);
-        } else if (t == "j") {
-            // unsigned int
-            ofLogNotice() << "unhandled unsigned int\n";
-        } else if (t == "x") {
-            // int64
-            ofLogNotice() << "unhandled int64\n";
-        } else if (t == "y") {
-            // uint64
-            ofLogNotice() << "unhandled unsigned int64\n";
-        } else if (t == "d") {
-            auto& p = static_cast< ofParameter<double>& >(group[i]);
-            expose(p, gp);
-        } else if (t == "f") {
-            auto& p = group.getFloat(group[i].getName());
-            expose(p, gp);
-        } else if (t == "b") {
-            auto& p = group.getBool(group[i].getName());
-            expose(p, gp);
-        } else if (t.find("basic_string") != std::string::npos) {
-            auto& p = group.getString(group[i].getName());
-            expose(p, gp);
-        } else if (t.find("ofColor_IhE") != std::string::npos) {
-            auto& p = group.getColor(group[i].getName());
-            expose(p, gp);
-        } else if (t.find("ofColor_IfE") != std::string::npos) {
-            auto& p = group.getFloatColor(group[i].getName());
-            expose(p, gp);
-        } else if (t.find("ofParameterGroup") != std::string::npos) {
-            auto& p = group.getGroup(group[i].getName());
-            expose(p, gp);
-        } else {
-            // unknown
-            ofLogNotice() << "unknown type: " << t << "\n";
-        }
-    }
+#include <typeinfo>
+#include <unordered_map>
 
-    groupIdMap[(void*)&group] = gp->getId();
-
-    return gp;
-}
-
-void ofxRabbitControlServer::remove(ofParameterGroup& group) {
-
-    auto it = groupIdMap.find((void*)&group);
-    if (it != groupIdMap.end()) {
-        // found
-
-        // fist, send remove parameter from clients
-        ParameterServer::removeParameter(it->second);
-
-        // remove from maps
-        groupIdMap.erase((void*)(&group));
-    }
-}
-
-
-//----------------------------------------------------
-//----------------------------------------------------
-// bool
-//----------------------------------------------------
-//----------------------------------------------------
-rcp::BooleanParameterPtr ofxRabbitControlServer::expose(ofParameter<bool> & param, const rcp::GroupParameterPtr& rabbitgroup)
+ofxRabbitControlServer::ofxRabbitControlServer()
 {
-    auto it = paramIdMap.find((void*)&param.get());
-    if (it != paramIdMap.end())
-    {
-        // already exposed
-        return std::dynamic_pointer_cast<rcp::BooleanParameter>(ParameterServer::getParameter(it->second));
-    }
+    // update runs every frame, send init in slices
+    // so a connecting client does not stall the others
+    setInitSliceSize(64 * 1024);
 
-    // setup
-    rcp::BooleanParameterPtr p;
-
-    if (rabbitgroup)
-    {
-        p = ParameterServer::createBooleanParameter(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    }
-    else
-    {
-        p = ParameterServer::createBooleanParameter(param.getName());
-    }
-
-    p->setValue(param.get());
-
-    p->addValueUpdatedCb([&param](bool& v)
-    {
-        param.set(v);
-    });
-
-    p->addUpdatedCb([&param, p]()
-    {
-        param.setName(p->getLabel());
-    });
-
-
-    // set change listener to update rcp parameter
-    param.addListener(this, &ofxRabbitControlServer::paramBoolChanged);
-
-    // insert into maps
-    paramIdMap[(void*)&param.get()] = p->getId();
-
-    return p;
-}
-
-void ofxRabbitControlServer::remove(ofParameter<bool> & param)
-{
-    ofParameterRemove(param);
-    param.removeListener(this, &ofxRabbitControlServer::paramBoolChanged);
+    ofAddListener(ofEvents().update, this, &ofxRabbitControlServer::appUpdate);
 }
 
-void ofxRabbitControlServer::paramBoolChanged(bool & value)
+ofxRabbitControlServer::~ofxRabbitControlServer()
 {
-    int16_t id = findParam(&value);
-    if (!id) {
-        return;
-    }
-
-    auto param = std::dynamic_pointer_cast<rcp::BooleanParameter >(ParameterServer::getParameter(id));
-    if (param) {
-        param->setValue(value);
-        // update
-        update();
-    }
+    ofRemoveListener(ofEvents().update, this, &ofxRabbitControlServer::appUpdate);
 }
 
-
-
-//----------------------------------------------------
-//----------------------------------------------------
-// int8
-//----------------------------------------------------
-//----------------------------------------------------
-rcp::Int8ParameterPtr ofxRabbitControlServer::expose(ofParameter<char> & param, const rcp::GroupParameterPtr& rabbitgroup)
+void ofxRabbitControlServer::appUpdate(ofEventArgs& args)
 {
-    auto it = paramIdMap.find((void*)&param.get());
-    if (it != paramIdMap.end())
-    {
-        // already exposed
-        return std::dynamic_pointer_cast<rcp::Int8Parameter>(ParameterServer::getParameter(it->second));
-    }
-
-    // setup
-    rcp::Int8ParameterPtr p;
-
-    if (rabbitgroup)
-    {
-        p = ParameterServer::createInt8Parameter(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    }
-    else
-    {
-        p = ParameterServer::createInt8Parameter(param.getName());
-    }
+    // values received since the last frame
+    applyInbound();
 
-    p->setMinimum(param.getMin());
-    p->setMaximum(param.getMax());
-    p->setValue(param.get());
+    // send changes once per interval,
+    // changes in between are merged
+    uint64_t now = ofGetElapsedTimeMillis();
 
-    p->addValueUpdatedCb([&param](int8_t& v)
+    if (updateInterval > 0 &&
+        now - lastUpdate < updateInterval)
     {
-        param.set(v);
-    });
-
-    p->addUpdatedCb([&param, p]()
-    {
-        param.setName(p->getLabel());
-    });
-
-    // set change listener to update rcp parameter
-    param.addListener(this, &ofxRabbitControlServer::paramInt8Changed);
-
-    // insert into maps
-    paramIdMap[(void*)&param.get()] = p->getId();
-
-    return p;
-}
-
-void ofxRabbitControlServer::remove(ofParameter<char> & param)
-{
-    ofParameterRemove(param);
-    param.removeListener(this, &ofxRabbitControlServer::paramInt8Changed);
-}
-
-void ofxRabbitControlServer::paramInt8Changed(char & value)
-{
-    int16_t id = findParam(&value);
-    if (!id) {
         return;
     }
 
-    auto param = std::dynamic_pointer_cast<rcp::Int8Parameter>(ParameterServer::getParameter(id));
-    if (param)
-    {
-        param->setValue(value);
-        // update
-        update();
-    }
+    lastUpdate = now;
+    update();
 }
 
-
-//----------------------------------------------------
-//----------------------------------------------------
-// int32
-//----------------------------------------------------
-//----------------------------------------------------
-rcp::Int32ParameterPtr ofxRabbitControlServer::expose(ofParameter<int> & param, const rcp::GroupParameterPtr& rabbitgroup)
+void ofxRabbitControlServer::applyInbound()
 {
-    auto it = paramIdMap.find((void*)&param.get());
-    if (it != paramIdMap.end())
-    {
-        // already exposed
-        return std::dynamic_pointer_cast<rcp::Int32Parameter>(ParameterServer::getParameter(it->second));
-    }
-
-    // setup
-    rcp::Int32ParameterPtr p;
-
-    if (rabbitgroup)
-    {
-        p = ParameterServer::createInt32Parameter(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    }
-    else
-    {
-        p = ParameterServer::createInt32Parameter(param.getName());
-    }
-
-    p->setMinimum(param.getMin());
-    p->setMaximum(param.getMax());
-    p->setValue(param.get());
+    inboundIds.drain(inboundDrained);
 
-    p->addValueUpdatedCb([&param](int32_t& v)
-    {
-        param.set(v);
-    });
-
-    p->addUpdatedCb([&param, p]()
-    {
-        param.setName(p->getLabel());
-    });
-
-    // set change listener to update rcp parameter
-    param.addListener(this, &ofxRabbitControlServer::paramInt32Changed);
-
-    // insert into maps
-    paramIdMap[(void*)&param.get()] = p->getId();
-
-    return p;
-}
-
-void ofxRabbitControlServer::remove(ofParameter<int> & param)
-{
-    ofParameterRemove(param);
-    param.removeListener(this, &ofxRabbitControlServer::paramInt32Changed);
-}
-
-void ofxRabbitControlServer::paramInt32Changed(int & value)
-{
-    int16_t id = findParam(&value);
-    if (!id) {
-        return;
+    for (short id : inboundDrained) {
+        auto it = bindingIds.find(id);
+        if (it != bindingIds.end()) {
+            it->second->apply();
+        }
     }
 
-    auto param = std::dynamic_pointer_cast<rcp::Int32Parameter>(ParameterServer::getParameter(id));
-    if (param) {
-        param->setValue(value);
-        // update
-        update();
-    }
+    inboundDrained.clear();
 }
 
 
+namespace {
 
-//----------------------------------------------------
-//----------------------------------------------------
-// float
-//----------------------------------------------------
-//----------------------------------------------------
-rcp::Float32ParameterPtr ofxRabbitControlServer::expose(ofParameter<float> & param, const rcp::GroupParameterPtr& rabbitgroup)
-{
-    auto it = paramIdMap.find((void*)&param.get());
-    if (it != paramIdMap.end())
-    {
-        // already exposed
-        return std::dynamic_pointer_cast<rcp::Float32Parameter>(ParameterServer::getParameter(it->second));
-    }
-
-    // setup
-    rcp::Float32ParameterPtr p;
-
-    if (rabbitgroup)
-    {
-        p = ParameterServer::createFloat32Parameter(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    }
-    else
-    {
-        p = ParameterServer::createFloat32Parameter(param.getName());
-    }
-
-    p->setMinimum(param.getMin());
-    p->setMaximum(param.getMax());
-    p->setValue(param.get());
-
-    p->getMinimum();
-
-    p->addValueUpdatedCb([&param](float& v)
-    {
-        param.set(v);
-    });
-
-    p->addUpdatedCb([&param, p]()
-    {
-        param.setName(p->getLabel());
-    });
-
-    // set change listener to update rcp parameter
-    param.addListener(this, &ofxRabbitControlServer::paramfloatChanged);
+typedef void (*ExposeFunction)(ofxRabbitControlServer&, ofAbstractParameter&, const rcp::GroupParameterPtr&);
+typedef void* (*BindingKeyFunction)(ofAbstractParameter&);
 
-    // insert into maps
-    paramIdMap[(void*)&param.get()] = p->getId();
+// how to expose a child and where its binding is kept
+struct ChildType {
+    ExposeFunction expose;
+    BindingKeyFunction bindingKey;
+};
+typedef std::unordered_map<std::string, ChildType> ChildTable;
 
-    return p;
+template <typename T>
+void exposeChild(ofxRabbitControlServer& server, ofAbstractParameter& param, const rcp::GroupParameterPtr& group) {
+    server.expose(static_cast< ofParameter<T>& >(param), group);
 }
 
-void ofxRabbitControlServer::remove(ofParameter<float> & param)
-{
-    ofParameterRemove(param);
-    param.removeListener(this, &ofxRabbitControlServer::paramfloatChanged);
+template <typename T>
+void* bindingKey(ofAbstractParameter& param) {
+    return (void*)&static_cast< ofParameter<T>& >(param).get();
 }
 
-void ofxRabbitControlServer::paramfloatChanged(float & value)
-{
-    int16_t id = findParam(&value);
-    if (!id) {
-        return;
-    }
-
-    auto param = std::dynamic_pointer_cast<rcp::Float32Parameter>(ParameterServer::getParameter(id));
-    if (param) {
-        param->setValue(value);
-        // update
-        update();
-    }
+void exposeGroup(ofxRabbitControlServer& server, ofAbstractParameter& param, const rcp::GroupParameterPtr& group) {
+    server.expose(static_cast< ofParameterGroup& >(param), group);
 }
 
-
-//----------------------------------------------------
-//----------------------------------------------------
-// double
-//----------------------------------------------------
-//----------------------------------------------------
-rcp::Float64ParameterPtr ofxRabbitControlServer::expose(ofParameter<double> & param, const rcp::GroupParameterPtr& rabbitgroup)
-{
-    auto it = paramIdMap.find((void*)&param.get());
-    if (it != paramIdMap.end())
-    {
-        // already exposed
-        return std::dynamic_pointer_cast<rcp::Float64Parameter>(ParameterServer::getParameter(it->second));
-    }
-
-    // setup
-    rcp::Float64ParameterPtr p;
-
-    if (rabbitgroup)
-    {
-        p = ParameterServer::createFloat64Parameter(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    }
-    else
-    {
-        p = ParameterServer::createFloat64Parameter(param.getName());
-    }
-
-    p->setMinimum(param.getMin());
-    p->setMaximum(param.getMax());
-    p->setValue(param.get());
-
-    p->addValueUpdatedCb([&param](double& v)
-    {
-        param.set(v);
-    });
-
-    p->addUpdatedCb([&param, p]()
-    {
-        param.setName(p->getLabel());
-    });
-
-    // set change listener to update rcp parameter
-    param.addListener(this, &ofxRabbitControlServer::paramDoubleChanged);
-
-    // insert into maps
-    paramIdMap[(void*)&param.get()] = p->getId();
-
-    return p;
+template <typename T>
+ChildTable::value_type childEntry() {
+    return ChildTable::value_type(typeid(T).name(), ChildType{ &exposeChild<T>, &bindingKey<T> });
 }
 
-void ofxRabbitControlServer::remove(ofParameter<double> & param)
-{
-    ofParameterRemove(param);
-    param.removeListener(this, &ofxRabbitControlServer::paramDoubleChanged);
+// valueType() of a child to the matching expose and binding key,
+// groups have no binding key
+const ChildTable& childTable() {
+    static const ChildTable table = {
+        childEntry<bool>(),
+        childEntry<char>(),
+        childEntry<signed char>(),
+        childEntry<unsigned char>(),
+        childEntry<short>(),
+        childEntry<unsigned short>(),
+        childEntry<int>(),
+        childEntry<unsigned int>(),
+        childEntry<long long>(),
+        childEntry<unsigned long long>(),
+        childEntry<float>(),
+        childEntry<double>(),
+        childEntry<std::string>(),
+        childEntry<ofColor>(),
+        childEntry<ofFloatColor>(),
+        ChildTable::value_type(typeid(ofParameterGroup).name(), ChildType{ &exposeGroup, nullptr })
+    };
+    return table;
 }
 
-void ofxRabbitControlServer::paramDoubleChanged(double & value)
-{
-    int16_t id = findParam(&value);
-    if (!id) {
-        return;
-    }
-
-    auto param = std::dynamic_pointer_cast<rcp::Float64Parameter>(ParameterServer::getParameter(id));
-    if (param) {
-        param->setValue(value);
-        // update
-        update();
-    }
 }
 
-
 //----------------------------------------------------
 //----------------------------------------------------
-// string
+// group
 //----------------------------------------------------
 //----------------------------------------------------
-rcp::StringParameterPtr ofxRabbitControlServer::expose(ofParameter<std::string> & param, const rcp::GroupParameterPtr& rabbitgroup)
-{
-    auto it = paramIdMap.find((void*)&param.get());
-    if (it != paramIdMap.end())
-    {
-        // already exposed
-        return std::dynamic_pointer_cast<rcp::StringParameter>(ParameterServer::getParameter(it->second));
-    }
-
-    // setup
-    rcp::StringParameterPtr p;
+rcp::GroupParameterPtr ofxRabbitControlServer::expose(ofParameterGroup& group, const rcp::GroupParameterPtr& rabbitgroup) {
 
-    if (rabbitgroup)
-    {
-        p = ParameterServer::createStringParameter(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    }
-    else
-    {
-        p = ParameterServer::createStringParameter(param.getName());
+    auto it = groupIdMap.find((void*)&group);
+    if (it != groupIdMap.end()) {
+        // already exposed - return parameter
+        return ParameterServer::getShared<rcp::GroupParameter>(it->second);
     }
 
-    p->setValue(param.get());
-
-    p->addValueUpdatedCb([&param](std::string& v)
-    {
-        param.set(v);
-    });
-
-    p->addUpdatedCb([&param, p]()
-    {
-        param.setName(p->getLabel());
-    });
-
-    // set change listener to update rcp parameter
-    param.addListener(this, &ofxRabbitControlServer::paramStringChanged);
-
-    // insert into maps
-    paramIdMap[(void*)&param.get()] = p->getId();
-
-    return p;
-}
-
-void ofxRabbitControlServer::remove(ofParameter<std::string> & param)
-{
-    ofParameterRemove(param);
-    param.removeListener(this, &ofxRabbitControlServer::paramStringChanged);
-}
-
-void ofxRabbitControlServer::paramStringChanged(std::string & value)
-{
-
-    int16_t id = findParam(&value);
-    if (!id) {
-        return;
+    rcp::GroupParameterPtr gp;
+    if (rabbitgroup) {
+        gp = ParameterServer::createGroupParameter(group.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
+    } else {
+        gp = ParameterServer::createGroupParameter(group.getName());
     }
 
-    auto param = std::dynamic_pointer_cast<rcp::StringParameter>(ParameterServer::getParameter(id));
-    if (param) {
-        param->setValue(value);
-        // update
-        update();
-    }
-}
+    // all children end up in gp
+    reserveParameters(group.size(), gp);
 
+    const ChildTable& table = childTable();
 
-//----------------------------------------------------
-//----------------------------------------------------
-// ofColor
-//----------------------------------------------------
-//----------------------------------------------------
-rcp::RGBAParameterPtr ofxRabbitControlServer::expose(ofParameter<ofColor> & param, const rcp::GroupParameterPtr& rabbitgroup)
-{
-    auto it = paramIdMap.find((void*)&param.get());
-    if (it != paramIdMap.end())
-    {
-        // already exposed
-        return std::dynamic_pointer_cast<rcp::RGBAParameter>(ParameterServer::getParameter(it->second));
-    }
+    for (std::size_t i = 0; i < group.size(); i++) {
 
-    // setup
-    rcp::RGBAParameterPtr p;
+        ofAbstractParameter& child = group[i];
+        std::string t = child.valueType();
 
-    if (rabbitgroup)
-    {
-        p = ParameterServer::createRGBAParameter(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    }
-    else
-    {
-        p = ParameterServer::createRGBAParameter(param.getName());
+        auto fn = table.find(t);
+        if (fn != table.end()) {
+            fn->second.expose(*this, child, gp);
+        } else {
+            // unknown
+            ofLogNotice() << "unknown type: " << t << "\n";
+        }
     }
 
-    uint32_t cv = param.get().r + (param.get().g << 8) + (param.get().b << 16) + (param.get().a << 24);
-    p->setValue(rcp::Color(cv));
-
-    p->addValueUpdatedCb([&param](rcp::Color& v)
-    {
-        uint32_t cv = v.getValue();
-        float r = cv & 0xFF;
-        float g = (cv >> 8) & 0xFF;
-        float b = (cv >> 16) & 0xFF;
-        float a = (cv >> 24) & 0xFF;
-
-        param.set(ofColor(r, g, b, a));
-    });
-
-    p->addUpdatedCb([&param, p]()
-    {
-        param.setName(p->getLabel());
-    });
-
-    // set change listener to update rcp parameter
-    param.addListener(this, &ofxRabbitControlServer::paramColorChanged);
-
-    // insert into maps
-    paramIdMap[(void*)&param.get()] = p->getId();
-
-    return p;
-}
+    groupIdMap[(void*)&group] = gp->getId();
 
-void ofxRabbitControlServer::remove(ofParameter<ofColor> & param)
-{
-    ofParameterRemove(param);
-    param.removeListener(this, &ofxRabbitControlServer::paramColorChanged);
+    return gp;
 }
 
-void ofxRabbitControlServer::paramColorChanged(ofColor & value)
-{
-    int16_t id = findParam(&value);
-    if (!id) {
-        return;
-    }
+void ofxRabbitControlServer::remove(ofParameterGroup& group) {
 
-    auto param = std::dynamic_pointer_cast<rcp::RGBAParameter>(ParameterServer::getParameter(id));
-    if (param) {
+    auto it = groupIdMap.find((void*)&group);
+    if (it != groupIdMap.end()) {
+        // found
+        int16_t id = it->second;
 
-        int r = value.r;
-        int g = value.g;
-        int b = value.b;
-        int a = value.a;
+        // stop listening to all children first,
+        // their rcp parameter are removed with the group
+        unbind(group);
 
-        uint32_t cv = r + (g << 8) + (b << 16) + (a << 24);
-        param->setValue(rcp::Color(cv));
-        // update
-        update();
+        // send remove parameter from clients
+        ParameterServer::removeParameter(id);
     }
 }
 
-//----------------------------------------------------
-//----------------------------------------------------
-// ofFloatColor
-// Quick fix to support ofFLoatColor by ofFloatColor -> ofColor conversion.
-// Please notice it loses 32bit float precision but 8bit.
-//----------------------------------------------------
-//----------------------------------------------------
-rcp::RGBAParameterPtr ofxRabbitControlServer::expose(ofParameter<ofFloatColor> & param, const rcp::GroupParameterPtr& rabbitgroup)
-{
-    auto it = paramIdMap.find((void*)&param.get());
-    if (it != paramIdMap.end())
-    {
-        // already exposed
-        return std::dynamic_pointer_cast<rcp::RGBAParameter>(ParameterServer::getParameter(it->second));
-    }
-
-    // setup
-    rcp::RGBAParameterPtr p;
-
-    if (rabbitgroup)
-    {
-        p = ParameterServer::createRGBAParameter(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
-    }
-    else
-    {
-        p = ParameterServer::createRGBAParameter(param.getName());
-    }
+void ofxRabbitControlServer::unbind(ofParameterGroup& group) {
 
-    ofColor tmp(param.get().r*255.0f, param.get().g*255.0f, param.get().b*255.0f, param.get().a*255.0f);
-    uint32_t cv = tmp.r + (tmp.g << 8) + (tmp.b << 16) + (tmp.a << 24);
-    p->setValue(rcp::Color(cv));
+    const ChildTable& table = childTable();
 
-    p->addValueUpdatedCb([&param](rcp::Color& v)
-    {
-        uint32_t cv = v.getValue();
-        float r = cv & 0xFF;
-        float g = (cv >> 8) & 0xFF;
-        float b = (cv >> 16) & 0xFF;
-        float a = (cv >> 24) & 0xFF;
-
-        param.set(ofColor(r, g, b, a));
-    });
-
-    p->addUpdatedCb([&param, p]()
-    {
-        param.setName(p->getLabel());
-    });
+    for (std::size_t i = 0; i < group.size(); i++) {
 
-    // set change listener to update rcp parameter
-    param.addListener(this, &ofxRabbitControlServer::paramFloatColorChanged);
+        ofAbstractParameter& child = group[i];
 
-    // insert into maps
-    paramIdMap[(void*)&param.get()] = p->getId();
+        auto fn = table.find(child.valueType());
+        if (fn == table.end()) {
+            continue;
+        }
 
-    return p;
-}
+        if (fn->second.bindingKey) {
 
-void ofxRabbitControlServer::remove(ofParameter<ofFloatColor> & param)
-{
-    ofParameterRemove(param);
-    param.removeListener(this, &ofxRabbitControlServer::paramFloatColorChanged);
-}
-
-void ofxRabbitControlServer::paramFloatColorChanged(ofFloatColor & value)
-{
-    int16_t id = findParam(&value);
-    if (!id) {
-        return;
+            auto binding = bindings.find(fn->second.bindingKey(child));
+            if (binding != bindings.end()) {
+                bindingIds.erase(binding->second->getId());
+                bindings.erase(binding);
+            }
+        } else {
+            unbind(static_cast< ofParameterGroup& >(child));
+        }
     }
 
-    auto param = std::dynamic_pointer_cast<rcp::RGBAParameter>(ParameterServer::getParameter(id));
-    if (param) {
-
-        int r = value.r * 255.0f;
-        int g = value.g * 255.0f;
-        int b = value.b * 255.0f;
-        int a = value.a * 255.0f;
-
-        uint32_t cv = r + (g << 8) + (b << 16) + (a << 24);
-        param->setValue(rcp::Color(cv));
-        // update
-        update();
-    }
+    groupIdMap.erase((void*)&group);
 }
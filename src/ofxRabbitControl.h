@@ -35,66 +35,107 @@
 #ifndef OFXRABBITCONTROL_H
 #define OFXRABBITCONTROL_H
 
+#include <memory>
+#include <unordered_map>
+
 #include "ofParameter.h"
+#include "ofEvents.h"
 
 #include "websocketServerTransporter.h"
 #include "rabbitholeWsServerTransporter.h"
 #include "rabbitControl/parameterserver.h"
+#include "ofxRabbitControlBinding.h"
 
 class ofxRabbitControlServer : public rcp::ParameterServer
 {
 public:
-    ofxRabbitControlServer() {}
-	
+    ofxRabbitControlServer();
+    ~ofxRabbitControlServer();
+
+public:
+    // changes are sent on ofEvents().update,
+    // at most every interval milliseconds. 0: every frame
+    void setUpdateInterval(uint64_t interval) {
+        updateInterval = interval;
+    }
+    uint64_t getUpdateInterval() const {
+        return updateInterval;
+    }
+
 public:
     rcp::GroupParameterPtr expose(ofParameterGroup& group, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
     void remove(ofParameterGroup& group);
 
-    rcp::BooleanParameterPtr expose(ofParameter<bool> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
-    rcp::Int8ParameterPtr expose(ofParameter<char> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
-    rcp::Int32ParameterPtr expose(ofParameter<int> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
-    rcp::Float32ParameterPtr expose(ofParameter<float> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
-    rcp::Float64ParameterPtr expose(ofParameter<double> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
-    rcp::StringParameterPtr expose(ofParameter<std::string> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
-    rcp::RGBAParameterPtr expose(ofParameter<ofColor> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
-    rcp::RGBAParameterPtr expose(ofParameter<ofFloatColor> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr());
-
-    void remove(ofParameter<bool> & param);
-    void remove(ofParameter<char> & param);
-    void remove(ofParameter<int> & param);
-    void remove(ofParameter<float> & param);
-    void remove(ofParameter<double> & param);
-    void remove(ofParameter<std::string> & param);
-    void remove(ofParameter<ofColor> & param);
-    void remove(ofParameter<ofFloatColor> & param);
-    
-    void paramBoolChanged(bool & value);
-    void paramInt8Changed(char & value);
-    void paramInt32Changed(int & value);
-    void paramfloatChanged(float & value);
-    void paramDoubleChanged(double & value);
-    void paramStringChanged(std::string & value);
-    void paramColorChanged(ofColor & value);
-    void paramFloatColorChanged(ofFloatColor & value);
-    
-private:
-    int16_t findParam(void* paramAdr);
+    // expose an ofParameter of any type with ofxRabbitControlTraits
+    template <typename T>
+    std::shared_ptr<typename ofxRabbitControlTraits<T>::Parameter> expose(ofParameter<T> & param, const rcp::GroupParameterPtr& rabbitgroup = rcp::GroupParameterPtr())
+    {
+        typedef typename ofxRabbitControlTraits<T>::Parameter Parameter;
+
+        auto it = bindings.find((void*)&param.get());
+        if (it != bindings.end())
+        {
+            // already exposed
+            return ParameterServer::getShared<Parameter>(it->second->getId());
+        }
+
+        // setup
+        std::shared_ptr<Parameter> p;
+
+        if (rabbitgroup)
+        {
+            p = ParameterServer::createParameter<Parameter>(param.getName(), const_cast<rcp::GroupParameterPtr&>(rabbitgroup));
+        }
+        else
+        {
+            p = ParameterServer::createParameter<Parameter>(param.getName());
+        }
+
+        // the binding listens to changes on both sides
+        ofxRabbitControlBinding* binding = new ofxRabbitControlParameterBinding<T>(param, p, inboundIds);
+
+        // insert into maps
+        bindings[(void*)&param.get()].reset(binding);
+        bindingIds[p->getId()] = binding;
+
+        return p;
+    }
 
     template <typename T>
-    void ofParameterRemove(ofParameter<T> param) {
-        int16_t id = findParam((void*)(&param.get()));
-        if (!id) {
+    void remove(ofParameter<T> & param)
+    {
+        auto it = bindings.find((void*)&param.get());
+        if (it == bindings.end()) {
             return;
         }
+
+        int16_t id = it->second->getId();
+
         // fist, send remove parameter from clients
         ParameterServer::removeParameter(id);
 
-        // remove from maps
-        paramIdMap.erase((void*)(&param.get()));
+        // remove from maps, stops listening to the ofParameter
+        bindingIds.erase(id);
+        bindings.erase(it);
     }
+    
+private:
+    void appUpdate(ofEventArgs& args);
+    void applyInbound();
+    // erase the bindings of group and its children, recursively
+    void unbind(ofParameterGroup& group);
+
+    // ids with a received value, set on the network thread
+    rcp::DirtySet inboundIds;
+    std::vector<short> inboundDrained;
 
-    std::map<void*, int16_t > paramIdMap;
+    // bound ofParameter by value address and by rcp id
+    std::map<void*, std::unique_ptr<ofxRabbitControlBinding> > bindings;
+    std::unordered_map<int16_t, ofxRabbitControlBinding*> bindingIds;
     std::map<void*, int16_t > groupIdMap;
+
+    uint64_t updateInterval{0};
+    uint64_t lastUpdate{0};
 };
 
 
@@ -0,0 +1,257 @@
+/*
+********************************************************************
+* ofxRabbitControl
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef OFXRABBITCONTROLBINDING_H
+#define OFXRABBITCONTROLBINDING_H
+
+#include <atomic>
+#include <memory>
+
+#include "ofParameter.h"
+
+#include "rabbitControl/parameter_intern.h"
+#include "rabbitControl/dirtyset.h"
+
+//----------------------------------------------------
+// rcp parameter type and value conversion of an ofParameter type
+//----------------------------------------------------
+template <typename T, typename P>
+struct ofxRabbitControlValueTraits
+{
+    typedef P Parameter;
+
+    static void setup(Parameter& p, ofParameter<T>& param) {
+        p.setValue(param.get());
+    }
+    static typename Parameter::value_type toRcp(const T& value) {
+        return value;
+    }
+    static T fromRcp(const typename Parameter::value_type& value) {
+        return value;
+    }
+};
+
+template <typename T, typename P>
+struct ofxRabbitControlNumberTraits : public ofxRabbitControlValueTraits<T, P>
+{
+    static void setup(P& p, ofParameter<T>& param) {
+        p.setMinimum(param.getMin());
+        p.setMaximum(param.getMax());
+        p.setValue(param.get());
+    }
+};
+
+template <typename T>
+struct ofxRabbitControlTraits;
+
+template <> struct ofxRabbitControlTraits<bool> : public ofxRabbitControlValueTraits<bool, rcp::BooleanParameter> {};
+template <> struct ofxRabbitControlTraits<char> : public ofxRabbitControlNumberTraits<char, rcp::Int8Parameter> {};
+template <> struct ofxRabbitControlTraits<signed char> : public ofxRabbitControlNumberTraits<signed char, rcp::Int8Parameter> {};
+template <> struct ofxRabbitControlTraits<unsigned char> : public ofxRabbitControlNumberTraits<unsigned char, rcp::UInt8Parameter> {};
+template <> struct ofxRabbitControlTraits<short> : public ofxRabbitControlNumberTraits<short, rcp::Int16Parameter> {};
+template <> struct ofxRabbitControlTraits<unsigned short> : public ofxRabbitControlNumberTraits<unsigned short, rcp::UInt16Parameter> {};
+template <> struct ofxRabbitControlTraits<int> : public ofxRabbitControlNumberTraits<int, rcp::Int32Parameter> {};
+template <> struct ofxRabbitControlTraits<unsigned int> : public ofxRabbitControlNumberTraits<unsigned int, rcp::UInt32Parameter> {};
+template <> struct ofxRabbitControlTraits<long long> : public ofxRabbitControlNumberTraits<long long, rcp::Int64Parameter> {};
+template <> struct ofxRabbitControlTraits<unsigned long long> : public ofxRabbitControlNumberTraits<unsigned long long, rcp::UInt64Parameter> {};
+template <> struct ofxRabbitControlTraits<float> : public ofxRabbitControlNumberTraits<float, rcp::Float32Parameter> {};
+template <> struct ofxRabbitControlTraits<double> : public ofxRabbitControlNumberTraits<double, rcp::Float64Parameter> {};
+
+template <>
+struct ofxRabbitControlTraits<std::string> : public ofxRabbitControlValueTraits<std::string, rcp::StringParameter>
+{
+    // pass text by reference, no temporary copies
+    static const std::string& toRcp(const std::string& value) {
+        return value;
+    }
+    static const std::string& fromRcp(const std::string& value) {
+        return value;
+    }
+};
+
+template <>
+struct ofxRabbitControlTraits<ofColor> : public ofxRabbitControlValueTraits<ofColor, rcp::RGBAParameter>
+{
+    static void setup(Parameter& p, ofParameter<ofColor>& param) {
+        p.setValue(toRcp(param.get()));
+    }
+    static rcp::Color toRcp(const ofColor& value) {
+        int r = value.r;
+        int g = value.g;
+        int b = value.b;
+        int a = value.a;
+
+        uint32_t cv = r + (g << 8) + (b << 16) + (a << 24);
+        return rcp::Color(cv);
+    }
+    static ofColor fromRcp(const rcp::Color& value) {
+        uint32_t cv = value.getValue();
+        float r = cv & 0xFF;
+        float g = (cv >> 8) & 0xFF;
+        float b = (cv >> 16) & 0xFF;
+        float a = (cv >> 24) & 0xFF;
+
+        return ofColor(r, g, b, a);
+    }
+};
+
+// Quick fix to support ofFLoatColor by ofFloatColor -> ofColor conversion.
+// Please notice it loses 32bit float precision but 8bit.
+template <>
+struct ofxRabbitControlTraits<ofFloatColor> : public ofxRabbitControlValueTraits<ofFloatColor, rcp::RGBAParameter>
+{
+    static void setup(Parameter& p, ofParameter<ofFloatColor>& param) {
+        p.setValue(toRcp(param.get()));
+    }
+    static rcp::Color toRcp(const ofFloatColor& value) {
+        ofColor tmp(value.r*255.0f, value.g*255.0f, value.b*255.0f, value.a*255.0f);
+        return ofxRabbitControlTraits<ofColor>::toRcp(tmp);
+    }
+    static ofFloatColor fromRcp(const rcp::Color& value) {
+        return ofxRabbitControlTraits<ofColor>::fromRcp(value);
+    }
+};
+
+
+//----------------------------------------------------
+// connects an exposed ofParameter with its rcp parameter
+//----------------------------------------------------
+class ofxRabbitControlBinding
+{
+public:
+    virtual ~ofxRabbitControlBinding() {}
+
+    virtual int16_t getId() const = 0;
+
+    // apply a received value, main thread only
+    virtual void apply() = 0;
+};
+
+template <typename T>
+class ofxRabbitControlParameterBinding : public ofxRabbitControlBinding
+{
+public:
+    typedef ofxRabbitControlTraits<T> Traits;
+    typedef typename Traits::Parameter Parameter;
+    typedef typename Parameter::value_type Value;
+
+    ofxRabbitControlParameterBinding(ofParameter<T>& param, const std::shared_ptr<Parameter>& p, rcp::DirtySet& inboundIds) :
+        param(param)
+      , parameter(p)
+      , inbound(std::make_shared<Inbound>())
+    {
+        Traits::setup(*parameter, param);
+
+        // received values are applied on the main thread,
+        // a newer value overwrites one not applied yet
+        int16_t id = parameter->getId();
+        std::shared_ptr<Inbound> pending = inbound;
+
+        parameter->addValueUpdatedCb([id, pending, &inboundIds](Value& v)
+        {
+            pending->lock();
+            pending->value = Traits::fromRcp(v);
+            pending->pending = true;
+            pending->unlock();
+
+            inboundIds.set(id);
+        });
+
+        ofParameter<T>& named = param;
+        Parameter* rp = parameter.get();
+        parameter->addUpdatedCb([&named, rp]()
+        {
+            named.setName(rp->getLabel());
+        });
+
+        // set change listener to update rcp parameter
+        param.addListener(this, &ofxRabbitControlParameterBinding::changed);
+    }
+
+    ~ofxRabbitControlParameterBinding() {
+        param.removeListener(this, &ofxRabbitControlParameterBinding::changed);
+    }
+
+    const std::shared_ptr<Parameter>& getParameter() const {
+        return parameter;
+    }
+
+    int16_t getId() const override {
+        return parameter->getId();
+    }
+
+    void apply() override {
+        // copy out, the listeners run without the slot locked
+        inbound->lock();
+        bool pending = inbound->pending;
+        if (pending) {
+            applying = inbound->value;
+            inbound->pending = false;
+        }
+        inbound->unlock();
+
+        if (pending) {
+            param.set(applying);
+        }
+    }
+
+    // ofParameter listener, no lookup
+    void changed(T& value) {
+        parameter->setValue(Traits::toRcp(value));
+    }
+
+private:
+    // preallocated slot for the latest received value,
+    // the spin flag is held only to copy a value in or out
+    struct Inbound {
+        void lock() {
+            while (busy.exchange(true, std::memory_order_acquire)) {}
+        }
+        void unlock() {
+            busy.store(false, std::memory_order_release);
+        }
+
+        std::atomic<bool> busy{false};
+        bool pending{false};
+        T value{};
+    };
+
+    ofParameter<T>& param;
+    std::shared_ptr<Parameter> parameter;
+    std::shared_ptr<Inbound> inbound;
+    // last applied value, main thread only
+    T applying{};
+};
+
+#endif // OFXRABBITCONTROLBINDING_H
@@ -0,0 +1,136 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_BUFFERREADER_H
+#define RCP_BUFFERREADER_H
+
+#include <cstddef>
+#include <cstring>
+
+namespace rcp {
+
+    /*
+     * BufferReader is a bounds-checked cursor over a non-owning
+     * (const char*, size_t) view.
+     * it mimics the subset of std::istream used by the parser:
+     * reading past the end sets eof and fail, peeking past the end sets eof.
+     * the viewed memory must outlive the reader.
+    */
+    class BufferReader
+    {
+    public:
+        static const int END = -1;
+
+        BufferReader(const char* data, size_t size) :
+            m_data(data)
+          , m_size(data ? size : 0)
+        {}
+
+        int get() {
+            if (m_fail || m_pos >= m_size) {
+                m_eof = true;
+                m_fail = true;
+                return END;
+            }
+            return static_cast<unsigned char>(m_data[m_pos++]);
+        }
+
+        int peek() {
+            if (m_fail || m_pos >= m_size) {
+                m_eof = true;
+                return END;
+            }
+            return static_cast<unsigned char>(m_data[m_pos]);
+        }
+
+        BufferReader& read(char* s, size_t n) {
+
+            if (m_fail) {
+                return *this;
+            }
+
+            if (n > remaining()) {
+                // copy what is left, same as istream
+                n = remaining();
+                m_eof = true;
+                m_fail = true;
+            }
+
+            if (n > 0) {
+                std::memcpy(s, m_data + m_pos, n);
+                m_pos += n;
+            }
+
+            return *this;
+        }
+
+        // advance the cursor without copying
+        // returns a pointer to the skipped bytes or nullptr if not enough data
+        const char* skip(size_t n) {
+
+            if (m_fail) {
+                return nullptr;
+            }
+
+            if (n > remaining()) {
+                m_pos = m_size;
+                m_eof = true;
+                m_fail = true;
+                return nullptr;
+            }
+
+            const char* p = m_data + m_pos;
+            m_pos += n;
+            return p;
+        }
+
+        bool eof() const { return m_eof; }
+        bool fail() const { return m_fail; }
+        bool good() const { return !m_eof && !m_fail; }
+
+        const char* data() const { return m_data; }
+        size_t size() const { return m_size; }
+        size_t position() const { return m_pos; }
+        size_t remaining() const { return m_size - m_pos; }
+
+    private:
+        const char* m_data;
+        size_t m_size;
+        size_t m_pos{0};
+        bool m_eof{false};
+        bool m_fail{false};
+    };
+}
+
+#endif // RCP_BUFFERREADER_H
@@ -0,0 +1,207 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_BUFFERWRITER_H
+#define RCP_BUFFERWRITER_H
+
+#include <string>
+#include <cstdio>
+#include <cstring>
+
+#include "types.h"
+#include "writeable.h"
+#include "sharedbuffer.h"
+
+namespace rcp {
+
+    // wire size of a value of datatype, 0 if the size depends on the value.
+    // only for datatypes where the mandatory typedefinition
+    // is the datatype byte alone.
+    // a single return statement to stay a C++11 constexpr
+    constexpr size_t fixedValueSize(datatype_t datatype) {
+        return (datatype == DATATYPE_BOOLEAN ||
+                datatype == DATATYPE_INT8 ||
+                datatype == DATATYPE_UINT8) ? 1 :
+               (datatype == DATATYPE_INT16 ||
+                datatype == DATATYPE_UINT16) ? 2 :
+               (datatype == DATATYPE_INT32 ||
+                datatype == DATATYPE_UINT32 ||
+                datatype == DATATYPE_FLOAT32 ||
+                datatype == DATATYPE_RGB ||
+                datatype == DATATYPE_RGBA ||
+                datatype == DATATYPE_IPV4) ? 4 :
+               (datatype == DATATYPE_INT64 ||
+                datatype == DATATYPE_UINT64 ||
+                datatype == DATATYPE_FLOAT64) ? 8 :
+               (datatype == DATATYPE_IPV6) ? 16 :
+               0;
+    }
+
+    /*
+     * BufferWriter writes big-endian into a contiguous growable buffer.
+     * multi-byte values are stored in one go, the serialized data
+     * can be accessed directly with data() and size().
+     *
+     * BufferWriter is final: code holding a BufferWriter gets
+     * the inline fixed-size writes without a virtual call.
+     * grow() and store() let an encoder reserve a fixed-size record
+     * once and fill it with plain stores.
+    */
+    class BufferWriter final : public Writer
+    {
+    public:
+        BufferWriter(size_t capacity = 256) {
+            m_buffer.reserve(capacity);
+        }
+
+        // Range and the other composite writes
+        using Writer::write;
+
+        virtual void write(const bool& c) { store(grow(1), c); }
+        virtual void write(const char& c) { m_buffer.push_back(c); }
+        virtual void write(const uint8_t& c) { m_buffer.push_back(static_cast<char>(c)); }
+        virtual void write(const int8_t& c) { m_buffer.push_back(static_cast<char>(c)); }
+        virtual void write(const uint16_t& c) { store(grow(sizeof(c)), c); }
+        virtual void write(const int16_t& c) { store(grow(sizeof(c)), c); }
+        virtual void write(const uint32_t& c) { store(grow(sizeof(c)), c); }
+        virtual void write(const int32_t& c) { store(grow(sizeof(c)), c); }
+        virtual void write(const uint64_t& c) { store(grow(sizeof(c)), c); }
+        virtual void write(const int64_t& c) { store(grow(sizeof(c)), c); }
+        virtual void write(const float& c) { store(grow(sizeof(c)), c); }
+        virtual void write(const double& c) { store(grow(sizeof(c)), c); }
+        virtual void write(const std::string& s, bool prefix = true);
+        virtual void write(const rcp::Color& s) { store(grow(4), s); }
+        virtual void write(const rcp::IPv4& s) { store(grow(4), s); }
+        virtual void write(const rcp::IPv6& s) { store(grow(16), s); }
+        virtual void write(const char* data, uint32_t length);
+
+        // append size bytes, returns where to store them
+        char* grow(size_t size) {
+            size_t offset = m_buffer.size();
+            m_buffer.resize(offset + size);
+            return &m_buffer[offset];
+        }
+
+        // store a value big-endian at p, returns the position after it
+        static char* store(char* p, bool v) {
+            *p = static_cast<char>(v ? 1 : 0);
+            return p + 1;
+        }
+        static char* store(char* p, char v) { *p = v; return p + 1; }
+        static char* store(char* p, uint8_t v) { return storeBigEndian(p, v); }
+        static char* store(char* p, int8_t v) { return storeBigEndian(p, static_cast<uint8_t>(v)); }
+        static char* store(char* p, uint16_t v) { return storeBigEndian(p, v); }
+        static char* store(char* p, int16_t v) { return storeBigEndian(p, static_cast<uint16_t>(v)); }
+        static char* store(char* p, uint32_t v) { return storeBigEndian(p, v); }
+        static char* store(char* p, int32_t v) { return storeBigEndian(p, static_cast<uint32_t>(v)); }
+        static char* store(char* p, uint64_t v) { return storeBigEndian(p, v); }
+        static char* store(char* p, int64_t v) { return storeBigEndian(p, static_cast<uint64_t>(v)); }
+
+        static char* store(char* p, float value) {
+            uint32_t v;
+            std::memcpy(&v, &value, sizeof(v));
+            return storeBigEndian(p, v);
+        }
+
+        static char* store(char* p, double value) {
+            uint64_t v;
+            std::memcpy(&v, &value, sizeof(v));
+            return storeBigEndian(p, v);
+        }
+
+        static char* store(char* p, const rcp::Color& v) { return storeBigEndian(p, v.getValue()); }
+        static char* store(char* p, const rcp::IPv4& v) { return storeBigEndian(p, v.getAddress()); }
+
+        static char* store(char* p, const rcp::IPv6& v) {
+            for (int i=0; i<4; i++) {
+                p = storeBigEndian(p, v.getAddress(i));
+            }
+            return p;
+        }
+
+
+        const char* data() const {
+            return m_buffer.data();
+        }
+
+        char* data() {
+            return &m_buffer[0];
+        }
+
+        size_t size() const {
+            return m_buffer.size();
+        }
+
+        size_t getSize() const {
+            return m_buffer.size();
+        }
+
+        void reserve(size_t capacity) {
+            m_buffer.reserve(capacity);
+        }
+
+        void clear() {
+            m_buffer.clear();
+        }
+
+        // moves the serialized data into a SharedBuffer.
+        // the writer is empty afterwards
+        SharedBufferPtr getSharedBuffer() {
+            SharedBufferPtr buffer = SharedBuffer::create(std::move(m_buffer));
+            m_buffer.clear();
+            return buffer;
+        }
+
+        void dump() {
+            for (size_t i=0; i<m_buffer.size(); i++) {
+                printf("0x%02X ", static_cast<uint8_t>(m_buffer[i]));
+            }
+            printf("\n");
+        }
+
+    private:
+        template<typename T>
+        static char* storeBigEndian(char* p, T v) {
+            for (size_t i=0; i<sizeof(T); i++) {
+                p[i] = static_cast<char>(v >> ((sizeof(T) - 1 - i) * 8));
+            }
+            return p + sizeof(T);
+        }
+
+        std::string m_buffer;
+    };
+}
+
+
+#endif // RCP_BUFFERWRITER_H
@@ -36,6 +36,10 @@
 #define CLIENTTRANSPORTER_H
 
 #include <map>
+#include <string>
+#include <istream>
+
+#include "sharedbuffer.h"
 
 namespace rcp {
 
@@ -45,7 +49,15 @@ namespace rcp {
     public:
         virtual void connected() = 0;
         virtual void disconnected() = 0;
-        virtual void received(std::istream& data) = 0;
+        // data is a view into the transporters receive buffer
+        // it is only valid during this call
+        virtual void received(const char* data, size_t size) = 0;
+
+        // convenience for stream based transporters
+        void received(std::istream& data) {
+            SharedBufferPtr buffer = SharedBuffer::create(data);
+            received(buffer->data(), buffer->size());
+        }
     };
 
 
@@ -74,7 +86,7 @@ namespace rcp {
             disconnected_cb.erase(c);
         }
 
-        void addReceivedCb(ClientTransporterListener* c, void(ClientTransporterListener::* func)(std::istream&)) {
+        void addReceivedCb(ClientTransporterListener* c, void(ClientTransporterListener::* func)(const char*, size_t)) {
             receive_cb[c] = func;
         }
         void removeReceivedCb(ClientTransporterListener* c) {
@@ -92,16 +104,20 @@ namespace rcp {
                 (kv.first->*kv.second)();
             }
         }
-        void _received(std::istream& in) {
+        void _received(const char* data, size_t size) {
             for (const auto& kv : receive_cb) {
-                (kv.first->*kv.second)(in);
+                (kv.first->*kv.second)(data, size);
             }
         }
+        void _received(std::istream& in) {
+            SharedBufferPtr buffer = SharedBuffer::create(in);
+            _received(buffer->data(), buffer->size());
+        }
 
 
         std::map<ClientTransporterListener*, void(ClientTransporterListener::*)()> connected_cb;
         std::map<ClientTransporterListener*, void(ClientTransporterListener::*)()> disconnected_cb;
-        std::map<ClientTransporterListener*, void(ClientTransporterListener::*)(std::istream&)> receive_cb;
+        std::map<ClientTransporterListener*, void(ClientTransporterListener::*)(const char*, size_t)> receive_cb;
     };
 
 }
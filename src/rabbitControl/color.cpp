@@ -10,7 +10,7 @@ namespace rcp {
         return u;
     }
 
-    Color readFromStream(std::istream& is, const Color& i) {
+    Color readFromStream(BufferReader& is, const Color& i) {
 
         uint32_t value;
         is.read(reinterpret_cast<char *>(&value), sizeof(uint32_t));
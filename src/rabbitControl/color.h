@@ -38,6 +38,8 @@
 #include <stdint.h>
 #include <ostream>
 
+#include "bufferreader.h"
+
 namespace rcp {
 
     class Color
@@ -64,7 +66,7 @@ namespace rcp {
     };
 
     Color& swap_endian(const Color& u);
-    Color readFromStream(std::istream& is, const Color& i);
+    Color readFromStream(BufferReader& is, const Color& i);
 
     std::ostream& operator<<(std::ostream& out, const Color& v);
 }
@@ -0,0 +1,208 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_DATATYPEREGISTRY_H
+#define RCP_DATATYPEREGISTRY_H
+
+#include <array>
+#include <cstddef>
+
+#include "types.h"
+#include "parameter_intern.h"
+#include "parameter_range.h"
+
+namespace rcp {
+
+    typedef ParameterPtr (*CreateParameterFn)(int16_t id);
+    typedef ParameterPtr (*CreateParameterReadValueFn)(int16_t id, BufferReader& is);
+    typedef bool (*ApplyValueFn)(IParameter& parameter, BufferReader& is);
+
+    /*
+     * DatatypeEntry holds what the parser needs for one datatype:
+     * create a parameter, create it with a value read from the stream
+     * and read a value into an existing parameter of that datatype.
+     * unsupported datatypes have an empty entry
+    */
+    struct DatatypeEntry
+    {
+        CreateParameterFn create;
+        CreateParameterReadValueFn createReadValue;
+        ApplyValueFn applyValue;
+    };
+
+
+    // parameter type of a datatype, void if not supported
+    template<datatype_t type_id> struct DatatypeParameter { typedef void type; };
+
+    template<> struct DatatypeParameter<DATATYPE_BOOLEAN> { typedef BooleanParameter type; };
+    template<> struct DatatypeParameter<DATATYPE_INT8> { typedef Int8Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_UINT8> { typedef UInt8Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_INT16> { typedef Int16Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_UINT16> { typedef UInt16Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_INT32> { typedef Int32Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_UINT32> { typedef UInt32Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_INT64> { typedef Int64Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_UINT64> { typedef UInt64Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_FLOAT32> { typedef Float32Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_FLOAT64> { typedef Float64Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_STRING> { typedef StringParameter type; };
+    template<> struct DatatypeParameter<DATATYPE_ENUM> { typedef EnumParameter type; };
+    template<> struct DatatypeParameter<DATATYPE_RGB> { typedef RGBParameter type; };
+    template<> struct DatatypeParameter<DATATYPE_RGBA> { typedef RGBAParameter type; };
+    template<> struct DatatypeParameter<DATATYPE_URI> { typedef URIParameter type; };
+    template<> struct DatatypeParameter<DATATYPE_IPV4> { typedef IPv4Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_IPV6> { typedef IPv6Parameter type; };
+    template<> struct DatatypeParameter<DATATYPE_BANG> { typedef BangParameter type; };
+    template<> struct DatatypeParameter<DATATYPE_GROUP> { typedef GroupParameter type; };
+
+    // range parameter type of an element datatype, void if not supported
+    template<datatype_t element_type_id> struct RangeDatatypeParameter { typedef void type; };
+
+    template<> struct RangeDatatypeParameter<DATATYPE_INT8> { typedef RangeParameter<int8_t> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_UINT8> { typedef RangeParameter<uint8_t> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_INT16> { typedef RangeParameter<int16_t> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_UINT16> { typedef RangeParameter<uint16_t> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_INT32> { typedef RangeParameter<int32_t> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_UINT32> { typedef RangeParameter<uint32_t> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_INT64> { typedef RangeParameter<int64_t> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_UINT64> { typedef RangeParameter<uint64_t> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_FLOAT32> { typedef RangeParameter<float> type; };
+    template<> struct RangeDatatypeParameter<DATATYPE_FLOAT64> { typedef RangeParameter<double> type; };
+
+
+    // the entry of a parameter type
+    template<typename P>
+    struct DatatypeThunks
+    {
+        static ParameterPtr create(int16_t id) {
+            return P::create(id);
+        }
+
+        static ParameterPtr createReadValue(int16_t id, BufferReader& is) {
+            auto p = P::create(id);
+            p->setValue(p->getDefaultTypeDefinition().readValue(is));
+            return p;
+        }
+
+        // parameter must be of datatype P::DATATYPE
+        static bool applyValue(IParameter& parameter, BufferReader& is) {
+            return static_cast<P&>(parameter).P::updateValue(is);
+        }
+
+        static constexpr DatatypeEntry entry() {
+            return DatatypeEntry{ &create, &createReadValue, &applyValue };
+        }
+    };
+
+    // parameter without value
+    template<typename P>
+    struct NoValueDatatypeThunks
+    {
+        static ParameterPtr create(int16_t id) {
+            return P::create(id);
+        }
+
+        static ParameterPtr createReadValue(int16_t id, BufferReader& /*is*/) {
+            return P::create(id);
+        }
+
+        static constexpr DatatypeEntry entry() {
+            return DatatypeEntry{ &create, &createReadValue, nullptr };
+        }
+    };
+
+    template<> struct DatatypeThunks<void> {
+        static constexpr DatatypeEntry entry() {
+            return DatatypeEntry{ nullptr, nullptr, nullptr };
+        }
+    };
+    template<> struct DatatypeThunks<BangParameter> : public NoValueDatatypeThunks<BangParameter> {};
+    template<> struct DatatypeThunks<GroupParameter> : public NoValueDatatypeThunks<GroupParameter> {};
+
+
+    typedef std::array<DatatypeEntry, DATATYPE_MAX_> DatatypeTable;
+
+    // compile-time list of table indices, std::index_sequence is C++14
+    template<std::size_t... I> struct DatatypeIndices {};
+
+    template<std::size_t N, std::size_t... I>
+    struct MakeDatatypeIndices : public MakeDatatypeIndices<N - 1, N - 1, I...> {};
+
+    template<std::size_t... I>
+    struct MakeDatatypeIndices<0, I...> {
+        typedef DatatypeIndices<I...> type;
+    };
+
+    template<std::size_t... I>
+    constexpr DatatypeTable makeDatatypeTable(DatatypeIndices<I...>) {
+        return DatatypeTable{{ DatatypeThunks<typename DatatypeParameter<static_cast<datatype_t>(I)>::type>::entry()... }};
+    }
+
+    template<std::size_t... I>
+    constexpr DatatypeTable makeRangeDatatypeTable(DatatypeIndices<I...>) {
+        return DatatypeTable{{ DatatypeThunks<typename RangeDatatypeParameter<static_cast<datatype_t>(I)>::type>::entry()... }};
+    }
+
+    /*
+     * DatatypeRegistry maps a datatype to its entry with one table lookup.
+     * the tables are built at compile time from DatatypeParameter
+     * and RangeDatatypeParameter, a new datatype is added there.
+    */
+    class DatatypeRegistry
+    {
+    public:
+        static const DatatypeEntry& get(datatype_t type_id) {
+            static constexpr DatatypeTable table = makeDatatypeTable(MakeDatatypeIndices<DATATYPE_MAX_>::type());
+            return lookup(table, type_id);
+        }
+
+        // range parameter by element datatype
+        static const DatatypeEntry& getRange(datatype_t element_type_id) {
+            static constexpr DatatypeTable table = makeRangeDatatypeTable(MakeDatatypeIndices<DATATYPE_MAX_>::type());
+            return lookup(table, element_type_id);
+        }
+
+    private:
+        static const DatatypeEntry& lookup(const DatatypeTable& table, datatype_t type_id) {
+            static constexpr DatatypeEntry none = DatatypeThunks<void>::entry();
+            if (type_id < 0 || type_id >= DATATYPE_MAX_) {
+                return none;
+            }
+            return table[type_id];
+        }
+    };
+
+}
+
+#endif // RCP_DATATYPEREGISTRY_H
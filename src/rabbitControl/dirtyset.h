@@ -0,0 +1,150 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_DIRTYSET_H
+#define RCP_DIRTYSET_H
+
+#include <atomic>
+#include <vector>
+#include <climits>
+#include <cstddef>
+#include <inttypes.h>
+
+namespace rcp {
+
+    /*
+     * DirtySet is a lock-free set of parameter ids.
+     * set() can be called from any thread without locking or allocating,
+     * drain() collects and clears all ids set so far.
+     * a summary word per 64 words keeps draining fast for sparse sets.
+    */
+    class DirtySet
+    {
+    public:
+        DirtySet() {
+            clear();
+        }
+
+        void set(short id) {
+
+            uint16_t i = static_cast<uint16_t>(id);
+            uint64_t mask = bit(i % 64);
+            std::atomic<uint64_t>& word = m_words[i / 64];
+
+            // already set, nothing to do
+            if ((word.load(std::memory_order_relaxed) & mask) != 0) {
+                return;
+            }
+
+            word.fetch_or(mask, std::memory_order_release);
+            m_summary[i / 4096].fetch_or(bit((i / 64) % 64), std::memory_order_release);
+        }
+
+        void reset(short id) {
+            uint16_t i = static_cast<uint16_t>(id);
+            m_words[i / 64].fetch_and(~bit(i % 64), std::memory_order_acq_rel);
+        }
+
+        bool test(short id) const {
+            uint16_t i = static_cast<uint16_t>(id);
+            return (m_words[i / 64].load(std::memory_order_acquire) & bit(i % 64)) != 0;
+        }
+
+        bool empty() const {
+            for (const auto& s : m_summary) {
+                if (s.load(std::memory_order_acquire) != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // append all set ids in ascending (unsigned) order and clear them
+        void drain(std::vector<short>& ids) {
+
+            for (size_t s=0; s<SUMMARY_WORDS; s++) {
+
+                uint64_t summary = m_summary[s].exchange(0, std::memory_order_acquire);
+
+                while (summary != 0) {
+
+                    size_t w = s * 64 + lowestBit(summary);
+                    summary &= summary - 1;
+
+                    uint64_t word = m_words[w].exchange(0, std::memory_order_acquire);
+
+                    while (word != 0) {
+                        ids.push_back(static_cast<short>(w * 64 + lowestBit(word)));
+                        word &= word - 1;
+                    }
+                }
+            }
+        }
+
+        void clear() {
+            for (auto& w : m_words) {
+                w.store(0, std::memory_order_relaxed);
+            }
+            for (auto& s : m_summary) {
+                s.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        static const size_t WORDS = (USHRT_MAX + 1) / 64;
+        static const size_t SUMMARY_WORDS = WORDS / 64;
+
+        static uint64_t bit(size_t i) {
+            return static_cast<uint64_t>(1) << i;
+        }
+
+        static size_t lowestBit(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_t>(__builtin_ctzll(v));
+#else
+            size_t n = 0;
+            while ((v & 1) == 0) {
+                v >>= 1;
+                n++;
+            }
+            return n;
+#endif
+        }
+
+        std::atomic<uint64_t> m_words[WORDS];
+        std::atomic<uint64_t> m_summary[SUMMARY_WORDS];
+    };
+}
+
+#endif // RCP_DIRTYSET_H
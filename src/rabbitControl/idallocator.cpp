@@ -0,0 +1,127 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#include "idallocator.h"
+
+namespace rcp {
+
+    IdAllocator::IdAllocator() :
+        m_used(USHRT_MAX + 1, false)
+    {
+    }
+
+    short IdAllocator::allocate()
+    {
+        // reuse released ids which left the quarantine
+        short id = allocateReleased(m_quarantine);
+        if (id != 0) {
+            return id;
+        }
+
+        // fresh ids
+        while (m_next < USHRT_MAX) {
+            uint16_t i = static_cast<uint16_t>(m_next++);
+            if (!m_used[i]) {
+                return take(i);
+            }
+        }
+
+        // all fresh ids used, ignore quarantine
+        return allocateReleased(0);
+    }
+
+    bool IdAllocator::reserve(short id)
+    {
+        if (m_used[index(id)]) {
+            return false;
+        }
+
+        take(index(id));
+        return true;
+    }
+
+    bool IdAllocator::release(short id)
+    {
+        uint16_t i = index(id);
+
+        if (!m_used[i]) {
+            return false;
+        }
+
+        m_used[i] = false;
+        m_count--;
+
+        if (i != 0 && i != USHRT_MAX) {
+            m_released.push_back(i);
+        }
+
+        return true;
+    }
+
+    bool IdAllocator::contains(short id) const
+    {
+        return m_used[index(id)];
+    }
+
+    void IdAllocator::clear()
+    {
+        m_used.assign(m_used.size(), false);
+        m_released.clear();
+        m_next = 1;
+        m_count = 0;
+    }
+
+    short IdAllocator::take(uint16_t index)
+    {
+        m_used[index] = true;
+        m_count++;
+        return static_cast<short>(index);
+    }
+
+    short IdAllocator::allocateReleased(size_t keep)
+    {
+        while (m_released.size() > keep) {
+
+            uint16_t i = m_released.front();
+            m_released.pop_front();
+
+            // id might have been reserved in the meantime
+            if (!m_used[i]) {
+                return take(i);
+            }
+        }
+
+        return 0;
+    }
+}
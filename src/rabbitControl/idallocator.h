@@ -0,0 +1,87 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_IDALLOCATOR_H
+#define RCP_IDALLOCATOR_H
+
+#include <vector>
+#include <deque>
+#include <climits>
+#include <cstddef>
+#include <inttypes.h>
+
+namespace rcp {
+
+    /*
+     * IdAllocator hands out parameter ids in O(1).
+     * ids are tracked in a bitmap, released ids are kept in a fifo.
+     * with a quarantine released ids are only reused after
+     * a number of other ids were released after them.
+     * id 0 (root) and -1 are never allocated.
+    */
+    class IdAllocator
+    {
+    public:
+        IdAllocator();
+
+        // returns 0 if no id is available
+        short allocate();
+
+        // mark an id as used, returns false if the id is already taken
+        bool reserve(short id);
+
+        // returns false if the id was not taken
+        bool release(short id);
+
+        bool contains(short id) const;
+        size_t size() const { return m_count; }
+        void clear();
+
+        void setQuarantine(size_t count) { m_quarantine = count; }
+        size_t getQuarantine() const { return m_quarantine; }
+
+    private:
+        static uint16_t index(short id) { return static_cast<uint16_t>(id); }
+        short take(uint16_t index);
+        short allocateReleased(size_t keep);
+
+        std::vector<bool> m_used;
+        std::deque<uint16_t> m_released;
+        uint32_t m_next{1};
+        size_t m_count{0};
+        size_t m_quarantine{0};
+    };
+}
+
+#endif // RCP_IDALLOCATOR_H
@@ -13,7 +13,7 @@ namespace rcp {
     public:
         //----------------------------------------
         // parser
-        static IdDataPtr parse(std::istream& is) {
+        static IdDataPtr parse(BufferReader& is) {
 
             // read mandatory
             int16_t parameter_id = readFromStream(is, parameter_id);
@@ -1,6 +1,9 @@
 #ifndef VERSIONDATA_H
 #define VERSIONDATA_H
 
+#include <vector>
+#include <algorithm>
+
 #include "writeable.h"
 #include "stream_tools.h"
 
@@ -15,7 +18,7 @@ namespace rcp {
     public:
         //----------------------------------------
         // parser
-        static InfoDataPtr parse(std::istream& is) {
+        static InfoDataPtr parse(BufferReader& is) {
 
             // read mandatory
             InfoDataPtr info_data = std::make_shared<InfoData>(readTinyString(is));
@@ -25,7 +28,7 @@ namespace rcp {
             while(!is.eof()) {
 
                 // read option prefix
-                infodata_options_t info_option = static_cast<infodata_options_t>(is.get());
+                uint8_t info_option = static_cast<uint8_t>(is.get());
 
                 if (info_option == TERMINATOR) {
                     break;
@@ -39,6 +42,31 @@ namespace rcp {
                     case INFODATA_OPTIONS_APPLICATIONID:
                         info_data->setApplicationId(readTinyString(is));
                     break;
+                    case INFODATA_OPTIONS_MULTIPACKET:
+                        info_data->setMultiPacket(true);
+                    break;
+                    case INFODATA_OPTIONS_SUBSCRIPTIONS:
+                        info_data->setAcceptsSubscriptions(true);
+                    break;
+                    case INFODATA_OPTIONS_SUBSCRIBE: {
+                        uint16_t length = readFromStream(is, length);
+                        for (uint16_t i = 0; i + 1 < length; i += 2) {
+                            int16_t group_id = readFromStream(is, group_id);
+                            info_data->addSubscription(group_id);
+                        }
+                        if (length % 2) {
+                            is.skip(1);
+                        }
+                        break;
+                    }
+                    default:
+                        // unknown flags have no payload,
+                        // unknown options after them carry their length
+                        if (info_option >= INFODATA_OPTIONS_LENGTH_PREFIXED_) {
+                            uint16_t length = readFromStream(is, length);
+                            is.skip(length);
+                        }
+                    break;
                 }
             }
 
@@ -78,6 +106,39 @@ namespace rcp {
 
         std::string getApplicationId() { return m_applicationId; }
 
+        //----------------------------------------
+        // multipacket
+        // sender can parse multiple packets in one message
+        void setMultiPacket(bool multiPacket) {
+            m_multiPacket = multiPacket;
+        }
+
+        bool getMultiPacket() const { return m_multiPacket; }
+
+        //----------------------------------------
+        // accepts subscriptions
+        // sender is a server that filters updates by subscriptions
+        void setAcceptsSubscriptions(bool accepts) {
+            m_acceptsSubscriptions = accepts;
+        }
+
+        bool getAcceptsSubscriptions() const { return m_acceptsSubscriptions; }
+
+        //----------------------------------------
+        // subscriptions
+        // sender only wants updates of these groups and their children.
+        // none: all updates.
+        // only send to a server that accepts subscriptions
+        void addSubscription(int16_t groupId) {
+            m_subscriptions.push_back(groupId);
+        }
+
+        void setSubscriptions(const std::vector<int16_t>& groupIds) {
+            m_subscriptions = groupIds;
+        }
+
+        const std::vector<int16_t>& getSubscriptions() const { return m_subscriptions; }
+
         //----------------------------------------
         // interface Writeable
         virtual void write(Writer& out, bool all) {
@@ -91,6 +152,24 @@ namespace rcp {
                 out.writeTinyString(m_applicationId);
             }
 
+            if (m_multiPacket) {
+                out.write(static_cast<char>(INFODATA_OPTIONS_MULTIPACKET));
+            }
+
+            if (m_acceptsSubscriptions) {
+                out.write(static_cast<char>(INFODATA_OPTIONS_SUBSCRIPTIONS));
+            }
+
+            if (!m_subscriptions.empty()) {
+                // length-prefixed, at most UINT16_MAX / 2 groups
+                size_t count = std::min<size_t>(m_subscriptions.size(), UINT16_MAX / 2);
+                out.write(static_cast<char>(INFODATA_OPTIONS_SUBSCRIBE));
+                out.write(static_cast<uint16_t>(count * sizeof(int16_t)));
+                for (size_t i = 0; i < count; i++) {
+                    out.write(m_subscriptions[i]);
+                }
+            }
+
             // terminator
             out.write(static_cast<char>(TERMINATOR));
         }
@@ -98,6 +177,9 @@ namespace rcp {
     private:
         std::string m_version;
         std::string m_applicationId;
+        bool m_multiPacket{false};
+        bool m_acceptsSubscriptions{false};
+        std::vector<int16_t> m_subscriptions;
     };
 }
 
@@ -26,7 +26,7 @@ namespace rcp {
         return u;
     }
 
-    IPv4 readFromStream(std::istream& is, const IPv4& i) {
+    IPv4 readFromStream(BufferReader& is, const IPv4& i) {
 
         uint32_t value;
         is.read(reinterpret_cast<char *>(&value), sizeof(uint32_t));
@@ -38,7 +38,7 @@ namespace rcp {
         return IPv4(value);
     }
 
-    IPv6 readFromStream(std::istream& is, const IPv6& i) {
+    IPv6 readFromStream(BufferReader& is, const IPv6& i) {
 
         uint32_t val1;
         uint32_t val2;
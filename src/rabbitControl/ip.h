@@ -38,12 +38,14 @@
 #include <ostream>
 #include <inttypes.h>
 
+#include "bufferreader.h"
+
 namespace rcp {
 
     class IPv4 {
 
     public:
-        IPv4() {}
+        IPv4() : m_ip(0) {}
         IPv4(const uint32_t& ip) {
             m_ip = ip;
         }
@@ -66,7 +68,7 @@ namespace rcp {
     class IPv6 {
 
     public:
-        IPv6() {}
+        IPv6() : m_ip() {}
         IPv6(uint32_t v1, uint32_t v2, uint32_t v3, uint32_t v4) {
             m_ip[0] = v1;
             m_ip[1] = v2;
@@ -105,8 +107,8 @@ namespace rcp {
     IPv4& swap_endian(const IPv4 &u);
     IPv6& swap_endian(const IPv6 &u);
 
-    IPv4 readFromStream(std::istream& is, const IPv4& i);
-    IPv6 readFromStream(std::istream& is, const IPv6& i);
+    IPv4 readFromStream(BufferReader& is, const IPv4& i);
+    IPv6 readFromStream(BufferReader& is, const IPv6& i);
 
 }
 
@@ -43,6 +43,7 @@
 #include "writeable.h"
 #include "optionparser.h"
 #include "typedefinition.h"
+#include "stringpool.h"
 
 namespace rcp {
 
@@ -50,6 +51,7 @@ namespace rcp {
     class ITypeDefinition;
     class IParameter;
     class IParameterManager;
+    class BufferWriter;
 
     typedef std::shared_ptr<IParameter> ParameterPtr;
 
@@ -102,8 +104,10 @@ namespace rcp {
         virtual std::weak_ptr<GroupParameter>& getParent() const = 0;
         virtual bool hasParent() const = 0;
 
-        virtual const std::vector<char> getUserdata() const = 0;
-        virtual void setUserdata(const std::vector<char> userdata) = 0;
+        virtual const std::vector<char>& getUserdata() const = 0;
+        virtual void setUserdata(const std::vector<char>& userdata) = 0;
+        virtual void setUserdata(std::vector<char>&& userdata) = 0;
+        virtual void setUserdata(const char* data, size_t size) = 0;
         virtual bool hasUserdata() const = 0;
         virtual void clearUserdata() = 0;
 
@@ -136,21 +140,37 @@ namespace rcp {
         //
         virtual bool isValueParameter() = 0;
 
+        // writeable
+        virtual IParameter* asParameter() { return this; }
+
+        // same key for parameter of the same value type, nullptr without value
+        virtual const void* getValueTypeKey() const { return nullptr; }
+
         template<typename, datatype_t, td_types> friend class TypeDefinition;
         friend class GroupParameter;
         friend class ParameterManager;
         friend class ParameterParser;
         friend class ParameterClient;
         friend class ParameterServer;
+        friend class Packet;
 
     protected:
         virtual void setDirty() = 0;
         virtual bool onlyValueChanged() const { return false; }
 
+        // write updatevalue data, use if onlyValueChanged()
+        virtual void writeUpdateValue(BufferWriter& out) = 0;
+
+        // share str with all parameter of the manager
+        virtual InternedString intern(const std::string& str) = 0;
+
+        // read a value and apply it in place
+        virtual bool updateValue(BufferReader& /*is*/) { return false; }
+
     private:
         virtual void setParent(GroupParameter& parent) = 0;
         virtual void clearParent() = 0;
-        virtual void setManager(std::shared_ptr<IParameterManager> manager) = 0;
+        virtual void setManager(const std::shared_ptr<IParameterManager>& manager) = 0;
 
     };
 
@@ -167,6 +187,7 @@ namespace rcp {
         // optional
         virtual const T& getValue() const = 0;
         virtual void setValue(const T& value) = 0;
+        virtual void setValue(T&& value) = 0;
         virtual bool hasValue() const = 0;
         virtual void clearValue() = 0;
 
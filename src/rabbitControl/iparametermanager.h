@@ -38,14 +38,17 @@
 #include <memory>
 
 #include "iparameter.h"
+#include "stringpool.h"
 
 namespace rcp {
 
     class IParameterManager {
     public:
         virtual ParameterPtr getParameter(const short& id) = 0;
+        virtual IParameter* findParameter(short id) = 0;
         virtual void setParameterDirty(IParameter& parameter) = 0;
         virtual void setParameterRemoved(ParameterPtr& parameter) = 0;
+        virtual InternedString intern(const std::string& str) = 0;
     };
 
     typedef std::shared_ptr<IParameterManager> ParameterManagerPtr;
@@ -35,10 +35,16 @@
 #ifndef RCP_OPTION_H
 #define RCP_OPTION_H
 
+#include <utility>
+
 #include "specializetypes.h"
 
 namespace rcp {
 
+    // tag to construct the value of an Option in place
+    struct InPlace {};
+    static const InPlace in_place = InPlace();
+
     template<typename T>
     class Option {
     public:
@@ -51,6 +57,22 @@ namespace rcp {
           , m_hasValue(true)
         {}
 
+        Option(T&& value) :
+            m_value(std::move(value))
+          , m_hasValue(true)
+        {}
+
+        template<typename... Args>
+        Option(InPlace, Args&&... args) :
+            m_value(std::forward<Args>(args)...)
+          , m_hasValue(true)
+        {}
+
+        Option(const Option&) = default;
+        Option(Option&&) = default;
+        Option& operator=(const Option&) = default;
+        Option& operator=(Option&&) = default;
+
         ~Option()
         {}
 
@@ -59,6 +81,11 @@ namespace rcp {
             m_hasValue = true;
         }
 
+        void setValue(T&& value) {
+            m_value = std::move(value);
+            m_hasValue = true;
+        }
+
         bool hasValue() const {
             return m_hasValue;
         }
@@ -67,7 +94,7 @@ namespace rcp {
             return m_value;
         }
 
-        void clearValue() const {
+        void clearValue() {
             m_hasValue = false;
         }
 
@@ -86,6 +113,13 @@ namespace rcp {
             return *this;
         }
 
+        Option& operator=(T&& value)
+        {
+            m_value = std::move(value);
+            m_hasValue = true;
+            return *this;
+        }
+
     private:
         T m_value;
         bool m_hasValue;
@@ -35,13 +35,13 @@
 #ifndef RCP_OPTIONPARSER_H
 #define RCP_OPTIONPARSER_H
 
-#include <istream>
+#include "bufferreader.h"
 
 namespace rcp {
 
     class IOptionparser {
     public:
-        virtual void parseOptions(std::istream& is) = 0;
+        virtual void parseOptions(BufferReader& is) = 0;
     };
 }
 
@@ -47,7 +47,7 @@ namespace rcp {
     class Packet : public Writeable
     {
     public:
-        static Option<Packet> parse(std::istream& is, std::shared_ptr<IParameterManager> manager = nullptr)
+        static Option<Packet> parse(BufferReader& is, const std::shared_ptr<IParameterManager>& manager = nullptr)
         {
             // read command
             command_t command = static_cast<command_t>(is.get());
@@ -67,7 +67,7 @@ namespace rcp {
             }
 
             // create valid packet
-            Option<Packet> packet_option = Packet(command);
+            Option<Packet> packet_option(in_place, command);
 
             //------------------------------------
             // handle update value
@@ -76,7 +76,7 @@ namespace rcp {
                 ParameterPtr param = ParameterParser::parseUpdateValue(is);
 
                 if (param != nullptr) {
-                    packet_option.getValue().setData(param);
+                    packet_option.getValue().setData(std::move(param));
                     return packet_option;
                 }
                 else
@@ -146,7 +146,7 @@ namespace rcp {
                         InfoDataPtr info_data = InfoData::parse(is);
                         if (info_data != nullptr)
                         {
-                            packet_option.getValue().setData(info_data);
+                            packet_option.getValue().setData(std::move(info_data));
                         }
                         else
                         {
@@ -163,17 +163,24 @@ namespace rcp {
 
                         if (id_data != nullptr)
                         {
-                            packet_option.getValue().setData(id_data);
+                            packet_option.getValue().setData(std::move(id_data));
                         }
 
                         break;
                     }
 
                     case COMMAND_DISCOVER:
-                        // TODO
-                        // exect ID-data or null
-                        // parameter-id followed by terminator
+                    {
+                        // expect ID-data of a group or null
+                        IdDataPtr id_data = IdData::parse(is);
+
+                        if (id_data != nullptr)
+                        {
+                            packet_option.getValue().setData(std::move(id_data));
+                        }
+
                         break;
+                    }
 
                     case COMMAND_UPDATE:
                     {
@@ -182,7 +189,7 @@ namespace rcp {
 
                         if (param != nullptr)
                         {
-                            packet_option.getValue().setData(param);
+                            packet_option.getValue().setData(std::move(param));
                         }
 
                         break;
@@ -195,7 +202,7 @@ namespace rcp {
 
                         if (id_data != nullptr)
                         {
-                            packet_option.getValue().setData(id_data);
+                            packet_option.getValue().setData(std::move(id_data));
                         }
 
                         break;
@@ -253,6 +260,14 @@ namespace rcp {
             setData(data);
         }
 
+        Packet(enum command_t cmd, WriteablePtr&& data) :
+            m_command(cmd)
+          , m_timestamp(0)
+          , m_hasTimestamp(false)
+        {
+            setData(std::move(data));
+        }
+
         Packet(const Packet& other) :
             m_hasTimestamp(false)
           , m_data(nullptr)
@@ -269,6 +284,16 @@ namespace rcp {
             }
         }
 
+        Packet(Packet&& other) :
+            m_command(other.m_command)
+          , m_timestamp(other.m_timestamp)
+          , m_hasTimestamp(other.m_hasTimestamp)
+          , m_data(std::move(other.m_data))
+          , m_hasData(other.m_hasData)
+        {
+            other.m_hasData = false;
+        }
+
         ~Packet();
 
 
@@ -292,37 +317,65 @@ namespace rcp {
             return *this;
         }
 
+        Packet& operator=(Packet&& other) {
+
+            m_command = other.m_command;
+            m_timestamp = other.m_timestamp;
+            m_hasTimestamp = other.m_hasTimestamp;
+            m_data = std::move(other.m_data);
+            m_hasData = other.m_hasData;
+
+            other.m_hasData = false;
+
+            return *this;
+        }
+
 
         // writeable interface
         virtual void write(Writer& out, bool all) {
+            write(out, all, m_command, m_hasTimestamp, m_timestamp, m_hasData ? m_data.get() : nullptr);
+        }
 
-            out.write(static_cast<char>(m_command));
+        // write a packet, data may be nullptr
+        static void write(Writer& out, bool all,
+                          command_t command,
+                          bool hasTimestamp,
+                          uint64_t timestamp,
+                          Writeable* data) {
 
-            if (m_command == COMMAND_UPDATEVALUE)
+            out.write(static_cast<char>(command));
+
+            if (command == COMMAND_UPDATEVALUE)
             {
                 // only parameter
-                ParameterPtr param = std::dynamic_pointer_cast<IParameter>(m_data);
-                if (param)
+                if (data && data->asParameter())
                 {
-                    param->write(out, all);
+                    data->write(out, all);
                 }
             }
             else
             {
-                if (m_hasTimestamp) {
+                if (hasTimestamp) {
                     out.write(static_cast<char>(PACKET_OPTIONS_TIMESTAMP));
-                    out.write(m_timestamp);
+                    out.write(timestamp);
                 }
 
-                if (m_hasData) {
+                if (data) {
                     out.write(static_cast<char>(PACKET_OPTIONS_DATA));
-                    m_data->write(out, all);
+                    data->write(out, all);
                 }
 
                 // terminator
                 out.write(static_cast<char>(TERMINATOR));
             }
+        }
+
 
+        // write a COMMAND_UPDATEVALUE packet for parameter,
+        // use if parameter.onlyValueChanged()
+        static void writeUpdateValue(BufferWriter& out, IParameter& parameter) {
+            out.write(static_cast<char>(COMMAND_UPDATEVALUE));
+            parameter.writeUpdateValue(out);
         }
 
 
@@ -370,7 +423,12 @@ namespace rcp {
             m_hasData = data != nullptr;
         }
 
-        WriteablePtr getData() const {
+        void setData(WriteablePtr&& data) {
+            m_data = std::move(data);
+            m_hasData = m_data != nullptr;
+        }
+
+        const WriteablePtr& getData() const {
             return m_data;
         }
 
@@ -394,6 +452,45 @@ namespace rcp {
     };
 
 
+    /*
+     * PacketView writes a packet for data it does not own.
+     * no reference to the data is taken, it must outlive the view.
+     * use it to encode outbound packets.
+    */
+    class PacketView
+    {
+    public:
+        PacketView(command_t cmd) :
+            m_command(cmd)
+          , m_timestamp(0)
+          , m_hasTimestamp(false)
+          , m_data(nullptr)
+        {}
+
+        PacketView(command_t cmd, Writeable& data) :
+            m_command(cmd)
+          , m_timestamp(0)
+          , m_hasTimestamp(false)
+          , m_data(&data)
+        {}
+
+        void setTimestamp(uint64_t timestamp) {
+            m_timestamp = timestamp;
+            m_hasTimestamp = true;
+        }
+
+        void write(Writer& out, bool all) const {
+            Packet::write(out, all, m_command, m_hasTimestamp, m_timestamp, m_data);
+        }
+
+    private:
+        command_t m_command;
+        uint64_t m_timestamp;
+        bool m_hasTimestamp;
+        Writeable* m_data;
+    };
+
+
     std::ostream& operator<<(std::ostream& out, Packet& Packet);
 }
 
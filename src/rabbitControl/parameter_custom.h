@@ -58,6 +58,16 @@ namespace rcp {
         ~CustomParameter()
         {}
 
+        // custom parameter of all value types share the datatype
+        static const void* valueTypeKey() {
+            static const char key = 0;
+            return &key;
+        }
+
+        virtual const void* getValueTypeKey() const {
+            return valueTypeKey();
+        }
+
         // convenience
         void setDefault(const T& v) {
             _CustomParameter::getDefaultTypeDefinition().setDefault(v);
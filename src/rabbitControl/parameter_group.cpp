@@ -44,9 +44,8 @@ namespace rcp {
 
     void GroupParameter::addChild(ParameterPtr& child) {
 
-        std::map<short, std::shared_ptr<IParameter > >::iterator it = obj->children.find(child->getId());
-        if (it == obj->children.end()) {
-            obj->children[child->getId()] = child;
+        if (!obj->children.contains(child->getId())) {
+            obj->children.set(child->getId(), child);
         }
 
         // set parent in child
@@ -55,8 +54,7 @@ namespace rcp {
 
     void GroupParameter::removeChild(IParameter& child) {
 
-        auto it = obj->children.find(child.getId());
-        if (it != obj->children.end()) {
+        if (obj->children.contains(child.getId())) {
             // found! - remove
             child.clearParent();
             obj->children.erase(child.getId());
@@ -37,15 +37,17 @@
 
 #include <cinttypes>
 #include <iostream>
-#include <istream>
 #include <string>
 #include <map>
 #include <vector>
+#include <memory>
 #include <functional>
 
 #include "stream_tools.h"
+#include "bufferwriter.h"
 #include "iparameter.h"
 #include "iparametermanager.h"
+#include "parametertable.h"
 
 #include "type_noopt.h"
 #include "type_default.h"
@@ -86,7 +88,7 @@ namespace rcp {
     {
     public:
         static std::shared_ptr< Parameter<TD> > create(int16_t id) {
-            return std::make_shared< Parameter<TD> >(id);
+            return make_pooled< Parameter<TD> >(id);
         }
 
         Parameter(const Parameter<TD>& v) :
@@ -94,13 +96,16 @@ namespace rcp {
         {}
 
         Parameter(int16_t id) :
-            obj(std::make_shared<Value>(id, TD(*this)))
+            obj(make_pooled<Value>(id, TD(*this)))
         {}
 
         virtual ParameterPtr newReference() {
-            return std::make_shared<Parameter<TD> >(*this);
+            return make_pooled<Parameter<TD> >(*this);
         }
 
+        // parameter without value have no value type key
+        static const void* valueTypeKey() { return nullptr; }
+
 
         //------------------------------------
         // implement writeable
@@ -120,10 +125,15 @@ namespace rcp {
             obj->write(out, all);
         }
 
+        virtual void writeUpdateValue(BufferWriter& out) {
+            // no value, a regular update
+            write(out, false);
+        }
+
 
         //------------------------------------
         // implement optionparser
-        virtual void parseOptions(std::istream& is) {
+        virtual void parseOptions(BufferReader& is) {
 
             while (!is.eof()) {
 
@@ -159,10 +169,10 @@ namespace rcp {
                         CHECK_STREAM
 
                         if (code_str == language_string_any) {
-                            obj->hasLabel = true;
-                            obj->label = label;
+                            obj->has |= OPTION_LABEL;
+                            obj->label = intern(label);
                         } else {
-                            obj->languageLabel[code_str] = label;
+                            obj->metadata().languageLabel[intern(code_str)] = intern(label);
                         }
 
                         // peek next byte
@@ -195,10 +205,10 @@ namespace rcp {
                         CHECK_STREAM
 
                         if (code_str == language_string_any) {
-                            obj->hasDescription = true;
-                            obj->description = description;
+                            obj->has |= OPTION_DESCRIPTION;
+                            obj->metadata().description = description;
                         } else {
-                            obj->languageDescription[code_str] = description;
+                            obj->metadata().languageDescription[intern(code_str)] = description;
                         }
 
                         // peek next byte
@@ -214,8 +224,8 @@ namespace rcp {
                     std::string st = readTinyString(is);
                     CHECK_STREAM
 
-                    obj->hasTags = true;
-                    obj->tags = st;
+                    obj->has |= OPTION_TAGS;
+                    obj->metadata().tags = intern(st);
                     break;
                 }
                 case PARAMETER_OPTIONS_ORDER: {
@@ -223,7 +233,7 @@ namespace rcp {
                     int32_t val = readFromStream(is, obj->order);
                     CHECK_STREAM
 
-                    obj->hasOrder = true;
+                    obj->has |= OPTION_ORDER;
                     obj->order = val;
                     break;
                 }
@@ -279,9 +289,9 @@ namespace rcp {
                 case PARAMETER_OPTIONS_USERDATA:
                 {
                     std::uint32_t size = readFromStream(is, size);
-                    std::vector<char> data;
-                    obj->userdata.resize(size);
-                    is.read(obj->userdata.data(), size);
+                    std::vector<char>& userdata = obj->metadata().userdata;
+                    userdata.resize(size);
+                    is.read(userdata.data(), size);
                     break;
                 }
                 case PARAMETER_OPTIONS_USERID: {
@@ -289,8 +299,8 @@ namespace rcp {
                     std::string st = readTinyString(is);
                     CHECK_STREAM
 
-                    obj->hasUserid = true;
-                    obj->userid = st;
+                    obj->has |= OPTION_USERID;
+                    obj->metadata().userid = intern(st);
                     break;
                 }
 
@@ -299,7 +309,7 @@ namespace rcp {
                     bool ro = readFromStream(is, ro);
                     CHECK_STREAM
 
-                    obj->hasReadonly = true;
+                    obj->has |= OPTION_READONLY;
                     obj->readonly = ro;
                     break;
                 }
@@ -333,25 +343,27 @@ namespace rcp {
         virtual const std::string getLabel() const { return obj->label; }
         virtual void setLabel(const std::string& label) {
 
-            obj->hasLabel = true;
+            obj->has |= OPTION_LABEL;
 
             if (obj->label == label) {
                 return;
             }
 
-            obj->label = label;
-            obj->labelChanged = true;
+            obj->label = intern(label);
+            obj->changed |= OPTION_LABEL;
 
             setDirty();
         }
-        virtual bool hasLabel() const { return obj->hasLabel; }
-        virtual void clearLabel() { obj->hasLabel = false; setDirty(); }
+        virtual bool hasLabel() const { return (obj->has & OPTION_LABEL) != 0; }
+        virtual void clearLabel() { obj->has &= ~OPTION_LABEL; setDirty(); }
 
         // label languages
         virtual std::vector<std::string> getLabelLanguages() const {
             std::vector<std::string> keys;
-            for(auto it = obj->languageLabel.begin(); it != obj->languageLabel.end(); ++it) {
-              keys.push_back(it->first);
+            if (obj->meta) {
+                for(auto it = obj->meta->languageLabel.begin(); it != obj->meta->languageLabel.end(); ++it) {
+                  keys.push_back(it->first);
+                }
             }
 
             return keys;
@@ -359,9 +371,11 @@ namespace rcp {
 
         virtual std::string getLanguageLabel(const std::string& code) const {
 
-            std::map<std::string, std::string>::iterator it = obj->languageLabel.find(code);
-            if (it != obj->languageLabel.end()) {
-                return it->second;
+            if (obj->meta) {
+                auto it = Metadata::findLanguage(obj->meta->languageLabel, code);
+                if (it != obj->meta->languageLabel.end()) {
+                    return it->second;
+                }
             }
 
             return empty_string;
@@ -369,50 +383,60 @@ namespace rcp {
 
         virtual void clearLanguageLabel() {
 
-            obj->languageLabel.clear();
-            obj->labelChanged = true;
+            if (obj->meta) {
+                obj->meta->languageLabel.clear();
+            }
+            obj->changed |= OPTION_LABEL;
             setDirty();
         }
 
         virtual void setLanguageLabel(const std::string& code, const std::string& label) {
 
-            obj->languageLabel[code] = label;
-            obj->labelChanged = true;
+            obj->metadata().languageLabel[intern(code)] = intern(label);
+            obj->changed |= OPTION_LABEL;
             setDirty();
         }
 
         virtual void removeLanguageLabel(const std::string& code) {
 
-            auto it = obj->languageLabel.find(code);
-            if (it != obj->languageLabel.end()) {
-                obj->languageLabel.erase(it);
+            if (!obj->meta) {
+                return;
+            }
+
+            auto it = Metadata::findLanguage(obj->meta->languageLabel, code);
+            if (it != obj->meta->languageLabel.end()) {
+                obj->meta->languageLabel.erase(it);
 
-                obj->labelChanged = true;
+                obj->changed |= OPTION_LABEL;
                 setDirty();
             }
         }
 
-        virtual const std::string& getDescription() const { return obj->description; }
+        virtual const std::string& getDescription() const {
+            return obj->meta ? obj->meta->description : empty_string;
+        }
         virtual void setDescription(const std::string& description) {
 
-            obj->hasDescription = true;
+            obj->has |= OPTION_DESCRIPTION;
 
-            if (obj->description == description) {
+            if (getDescription() == description) {
                 return;
             }
 
-            obj->description = description;
-            obj->descriptionChanged = true;
+            obj->metadata().description = description;
+            obj->changed |= OPTION_DESCRIPTION;
             setDirty();
         }
-        virtual bool hasDescription() const { return obj->hasDescription; }
-        virtual void clearDescription() { obj->hasDescription = false; setDirty(); }
+        virtual bool hasDescription() const { return (obj->has & OPTION_DESCRIPTION) != 0; }
+        virtual void clearDescription() { obj->has &= ~OPTION_DESCRIPTION; setDirty(); }
 
         // description languages
         virtual std::vector<std::string> getDescriptionLanguages() const {
             std::vector<std::string> keys;
-            for(auto it = obj->languageDescription.begin(); it != obj->languageDescription.end(); ++it) {
-              keys.push_back(it->first);
+            if (obj->meta) {
+                for(auto it = obj->meta->languageDescription.begin(); it != obj->meta->languageDescription.end(); ++it) {
+                  keys.push_back(it->first);
+                }
             }
 
             return keys;
@@ -420,9 +444,11 @@ namespace rcp {
 
         virtual std::string getDescriptionLanguage(const std::string& code) const {
 
-            std::map<std::string, std::string>::iterator it = obj->languageDescription.find(code);
-            if (it != obj->languageDescription.end()) {
-                return it->second;
+            if (obj->meta) {
+                auto it = Metadata::findLanguage(obj->meta->languageDescription, code);
+                if (it != obj->meta->languageDescription.end()) {
+                    return it->second;
+                }
             }
 
             return empty_string;
@@ -430,46 +456,54 @@ namespace rcp {
 
         virtual void clearDescriptionLanguage() {
 
-            obj->languageDescription.clear();
-            obj->descriptionChanged = true;
+            if (obj->meta) {
+                obj->meta->languageDescription.clear();
+            }
+            obj->changed |= OPTION_DESCRIPTION;
             setDirty();
         }
 
         virtual void setDescriptionLanguage(const std::string& code, const std::string& description) {
 
-            obj->languageDescription[code] = description;
-            obj->descriptionChanged = true;
+            obj->metadata().languageDescription[intern(code)] = description;
+            obj->changed |= OPTION_DESCRIPTION;
             setDirty();
         }
 
         virtual void removeDescriptionLanguage(const std::string& code) {
 
-            auto it = obj->languageDescription.find(code);
-            if (it != obj->languageDescription.end()) {
-                obj->languageDescription.erase(it);
+            if (!obj->meta) {
+                return;
+            }
+
+            auto it = Metadata::findLanguage(obj->meta->languageDescription, code);
+            if (it != obj->meta->languageDescription.end()) {
+                obj->meta->languageDescription.erase(it);
 
-                obj->descriptionChanged = true;
+                obj->changed |= OPTION_DESCRIPTION;
                 setDirty();
             }
         }
 
-        virtual const std::string& getTags() const { return obj->tags; }
+        virtual const std::string& getTags() const {
+            return obj->meta ? obj->meta->tags.str() : empty_string;
+        }
         virtual void setTags(const std::string& tags) {
 
-            obj->hasTags = true;
+            obj->has |= OPTION_TAGS;
 
-            if (obj->tags == tags) {
+            if (getTags() == tags) {
                 return;
             }
 
-            obj->tags = tags;
-            obj->tagsChanged = true;
+            obj->metadata().tags = intern(tags);
+            obj->changed |= OPTION_TAGS;
             setDirty();
         }
-        virtual bool hasTags() const { return obj->hasTags; }
+        virtual bool hasTags() const { return (obj->has & OPTION_TAGS) != 0; }
         virtual void clearTags() {
-            obj->hasTags = false;
-            obj->tagsChanged = true;
+            obj->has &= ~OPTION_TAGS;
+            obj->changed |= OPTION_TAGS;
             setDirty();
         }
 
@@ -477,20 +511,20 @@ namespace rcp {
         virtual const int32_t& getOrder() const { return obj->order; }
         virtual void setOrder(const int32_t& order) {
 
-            obj->hasOrder = true;
+            obj->has |= OPTION_ORDER;
 
             if (obj->order == order) {
                 return;
             }
 
             obj->order = order;
-            obj->orderChanged = true;
+            obj->changed |= OPTION_ORDER;
             setDirty();
         }
-        virtual bool hasOrder() const { return obj->hasOrder; }
+        virtual bool hasOrder() const { return (obj->has & OPTION_ORDER) != 0; }
         virtual void clearOrder() {
-            obj->hasOrder = false;
-            obj->orderChanged = true;
+            obj->has &= ~OPTION_ORDER;
+            obj->changed |= OPTION_ORDER;
             setDirty();
         }
 
@@ -501,38 +535,55 @@ namespace rcp {
 
         //----------------------
         // userdata
-        virtual const std::vector<char> getUserdata() const { return obj->userdata; }
-        virtual void setUserdata(const std::vector<char> userdata) {
-            obj->userdata = userdata;
-            obj->userdataChanged = true;
+        virtual const std::vector<char>& getUserdata() const {
+            static const std::vector<char> empty_userdata;
+            return obj->meta ? obj->meta->userdata : empty_userdata;
+        }
+        virtual void setUserdata(const std::vector<char>& userdata) {
+            obj->metadata().userdata = userdata;
+            obj->changed |= OPTION_USERDATA;
             setDirty();
         }
-        virtual bool hasUserdata() const { return obj->userdata.size() > 0; }
+        virtual void setUserdata(std::vector<char>&& userdata) {
+            obj->metadata().userdata = std::move(userdata);
+            obj->changed |= OPTION_USERDATA;
+            setDirty();
+        }
+        virtual void setUserdata(const char* data, size_t size) {
+            obj->metadata().userdata.assign(data, data + size);
+            obj->changed |= OPTION_USERDATA;
+            setDirty();
+        }
+        virtual bool hasUserdata() const { return obj->meta && obj->meta->userdata.size() > 0; }
         virtual void clearUserdata() {
-            obj->userdata.clear();
-            obj->userdataChanged = true;
+            if (obj->meta) {
+                obj->meta->userdata.clear();
+            }
+            obj->changed |= OPTION_USERDATA;
             setDirty();
         }
 
         //----------------------
         // userid
-        virtual const std::string& getUserid() const { return obj->userid; }
+        virtual const std::string& getUserid() const {
+            return obj->meta ? obj->meta->userid.str() : empty_string;
+        }
         virtual void setUserid(const std::string& userid) {
 
-            obj->hasUserid = true;
+            obj->has |= OPTION_USERID;
 
-            if (obj->userid == userid) {
+            if (getUserid() == userid) {
                 return;
             }
 
-            obj->userid = userid;
-            obj->useridChanged = true;
+            obj->metadata().userid = intern(userid);
+            obj->changed |= OPTION_USERID;
             setDirty();
         }
-        virtual bool hasUserid() const { return obj->hasUserid; }
+        virtual bool hasUserid() const { return (obj->has & OPTION_USERID) != 0; }
         virtual void clearUserid() {
-            obj->hasUserid = false;
-            obj->useridChanged = true;
+            obj->has &= ~OPTION_USERID;
+            obj->changed |= OPTION_USERID;
             setDirty();
         }
 
@@ -541,20 +592,20 @@ namespace rcp {
         virtual const bool& getReadonly() const { return obj->readonly; };
         virtual void setReadonly(const bool& readonly) {
 
-            obj->hasReadonly = true;
+            obj->has |= OPTION_READONLY;
 
             if (obj->readonly == readonly) {
                 return;
             }
 
             obj->readonly = readonly;
-            obj->readonlyChanged = true;
+            obj->changed |= OPTION_READONLY;
             setDirty();
         }
-        virtual bool hasReadonly() const { return obj->hasReadonly; };
+        virtual bool hasReadonly() const { return (obj->has & OPTION_READONLY) != 0; };
         virtual void clearReadonly() {
-            obj->hasReadonly = false;
-            obj->readonlyChanged = true;
+            obj->has &= ~OPTION_READONLY;
+            obj->changed |= OPTION_READONLY;
             setDirty();
         }
 
@@ -573,7 +624,7 @@ namespace rcp {
                 }
             }
 
-            UpdateEventHolderPtr event = std::make_shared<UpdateEventHolder>(func);
+            UpdateEventHolderPtr event = make_pooled<UpdateEventHolder>(func);
             obj->updatedCallbacks.push_back(std::move(event));
             return obj->updatedCallbacks.back()->callback;
         }
@@ -587,7 +638,7 @@ namespace rcp {
                 }
             }
 
-            UpdateEventHolderPtr event = std::make_shared<UpdateEventHolder>(func);
+            UpdateEventHolderPtr event = make_pooled<UpdateEventHolder>(func);
             obj->updatedCallbacks.push_back(std::move(event));
             return obj->updatedCallbacks.back()->callback;
         }
@@ -615,7 +666,7 @@ namespace rcp {
         template<typename, typename, datatype_t> friend class ValueParameter;
 
     protected:
-        virtual bool handleOption(const parameter_options_t& opt, std::istream& is) {
+        virtual bool handleOption(const parameter_options_t& opt, BufferReader& is) {
             return false;
         }
 
@@ -628,15 +679,15 @@ namespace rcp {
             }
         }
 
+        virtual InternedString intern(const std::string& str) {
+            if (auto p = obj->parameterManager.lock()) {
+                return p->intern(str);
+            }
+            return InternedString(str);
+        }
+
         bool anyOptionChanged() const {
-            return obj->labelChanged
-                    || obj->descriptionChanged
-                    || obj->tagsChanged
-                    || obj->orderChanged
-                    || obj->parentChanged
-                    || obj->userdataChanged
-                    || obj->useridChanged
-                    || obj->readonlyChanged;
+            return obj->changed != 0;
         }
 
     private:
@@ -645,12 +696,38 @@ namespace rcp {
         virtual void setParent(GroupParameterPtr parent);
         virtual void clearParent() {
             obj->parent.reset();
-            obj->parentChanged = true;
+            obj->changed |= OPTION_PARENT;
             setDirty();
         }
 
-        virtual void setManager(std::shared_ptr<IParameterManager> manager) {
-            obj->parameterManager = manager;            
+        virtual void setManager(const std::shared_ptr<IParameterManager>& manager) {
+            obj->parameterManager = manager;
+
+            if (manager) {
+                // share strings set before the parameter was managed
+                obj->label = manager->intern(obj->label);
+                if (obj->meta) {
+                    obj->meta->tags = manager->intern(obj->meta->tags);
+                    obj->meta->userid = manager->intern(obj->meta->userid);
+
+                    // keys are const, rebuild the language maps
+                    if (!obj->meta->languageLabel.empty()) {
+                        std::map<InternedString, InternedString> labels;
+                        for (auto& l : obj->meta->languageLabel) {
+                            labels.insert(std::make_pair(manager->intern(l.first), manager->intern(l.second)));
+                        }
+                        obj->meta->languageLabel.swap(labels);
+                    }
+
+                    if (!obj->meta->languageDescription.empty()) {
+                        std::map<InternedString, std::string> descriptions;
+                        for (auto& d : obj->meta->languageDescription) {
+                            descriptions.insert(std::make_pair(manager->intern(d.first), std::move(d.second)));
+                        }
+                        obj->meta->languageDescription.swap(descriptions);
+                    }
+                }
+            }
         }
 
         class UpdateEventHolder {
@@ -661,37 +738,56 @@ namespace rcp {
         };
         typedef std::shared_ptr<UpdateEventHolder> UpdateEventHolderPtr;
 
+        // bits of Value::has and Value::changed
+        enum : uint16_t {
+            OPTION_LABEL = 1 << 0,
+            OPTION_DESCRIPTION = 1 << 1,
+            OPTION_TAGS = 1 << 2,
+            OPTION_ORDER = 1 << 3,
+            OPTION_PARENT = 1 << 4,
+            OPTION_USERDATA = 1 << 5,
+            OPTION_USERID = 1 << 6,
+            OPTION_READONLY = 1 << 7
+        };
+
+        // options most parameter never set, allocated on first use
+        class Metadata {
+        public:
+            // keyed by language code
+            std::map<InternedString, InternedString> languageLabel;
+            std::string description;
+            std::map<InternedString, std::string> languageDescription;
+            InternedString tags;
+            std::vector<char> userdata;
+            InternedString userid;
+
+            // few languages per parameter, find a code without building a key
+            template<typename M>
+            static typename M::const_iterator findLanguage(const M& map, const std::string& code) {
+                typename M::const_iterator it = map.begin();
+                for (; it != map.end(); ++it) {
+                    if (it->first == code) {
+                        break;
+                    }
+                }
+                return it;
+            }
+        };
+
         class Value {
         public:
             Value(int16_t id, const TD& td) :
                 parameter_id(id)
+              , has(0)
+              , changed(0)
               , typeDefinition(td)
-            {
-                // init vars
-                label = empty_string;
-                hasLabel = false;
-                labelChanged = false;
-
-                description = empty_string;
-                hasDescription = false;
-                descriptionChanged = false;
-
-                tags = empty_string;
-                hasTags = false;
-                tagsChanged = false;
-
-                order = 0;
-                hasOrder = false;
-                orderChanged = false;
-
-                parentChanged = false;
-
-                userdata.clear();
-                userdataChanged = false;
+            {}
 
-                userid = empty_string;
-                hasUserid = false;
-                useridChanged = false;
+            Metadata& metadata() {
+                if (!meta) {
+                    meta.reset(new Metadata());
+                }
+                return *meta;
             }
 
             // write label and all language labels
@@ -699,20 +795,22 @@ namespace rcp {
 
                 out.write(static_cast<char>(PARAMETER_OPTIONS_LABEL));
 
-                if (hasLabel) {
+                if (has & OPTION_LABEL) {
 
                     out.write(language_string_any, false);
                     out.writeTinyString(label);
                 }
 
-                for (auto& l : languageLabel) {
+                if (meta) {
+                    for (auto& l : meta->languageLabel) {
 
-                    if (l.first.length() < 3) {
-                        continue;
-                    }
+                        if (l.first.str().length() < 3) {
+                            continue;
+                        }
 
-                    out.write(l.first.substr(0, 3), false);
-                    out.writeTinyString(l.second);
+                        out.write(l.first.str().substr(0, 3), false);
+                        out.writeTinyString(l.second);
+                    }
                 }
 
                 out.write(static_cast<char>(TERMINATOR));
@@ -723,20 +821,22 @@ namespace rcp {
 
                 out.write(static_cast<char>(PARAMETER_OPTIONS_DESCRIPTION));
 
-                if (hasDescription) {
+                if (has & OPTION_DESCRIPTION) {
 
                     out.write(language_string_any, false);
-                    out.writeShortString(description);
+                    out.writeShortString(meta ? meta->description : empty_string);
                 }
 
-                for (auto& l : languageDescription) {
+                if (meta) {
+                    for (auto& l : meta->languageDescription) {
 
-                    if (l.first.length() < 3) {
-                        continue;
-                    }
+                        if (l.first.str().length() < 3) {
+                            continue;
+                        }
 
-                    out.write(l.first.substr(0, 3), false);
-                    out.writeShortString(l.second);
+                        out.write(l.first.str().substr(0, 3), false);
+                        out.writeShortString(l.second);
+                    }
                 }
 
                 out.write(static_cast<char>(TERMINATOR));
@@ -746,158 +846,134 @@ namespace rcp {
             // write all options
             void write(Writer& out, bool all) {
 
-                // label
-                if (hasLabel || languageLabel.size() > 0) {
+                if (!all && changed == 0) {
+                    // nothing to write
+                    return;
+                }
 
-                    if (all || labelChanged) {
+                // label
+                if ((has & OPTION_LABEL) || (meta && meta->languageLabel.size() > 0)) {
 
+                    if (all || (changed & OPTION_LABEL)) {
                         writeLabel(out);
-
-                        if (!all) {
-                            labelChanged = false;
-                        }
                     }
-                } else if(labelChanged) {
+                } else if (changed & OPTION_LABEL) {
 
                     out.write(static_cast<char>(PARAMETER_OPTIONS_LABEL));
                     out.write(static_cast<char>(0));
-                    labelChanged = false;
+                    changed &= ~OPTION_LABEL;
                 }
 
 
                 // description
-                if (hasDescription || languageDescription.size() > 0) {
-
-                    if (all || descriptionChanged) {
+                if ((has & OPTION_DESCRIPTION) || (meta && meta->languageDescription.size() > 0)) {
 
+                    if (all || (changed & OPTION_DESCRIPTION)) {
                         writeDescription(out);
-
-                        if (!all) {
-                            descriptionChanged = false;
-                        }
                     }
-                } else if (descriptionChanged) {
+                } else if (changed & OPTION_DESCRIPTION) {
 
                     out.write(static_cast<char>(PARAMETER_OPTIONS_DESCRIPTION));
                     out.write(static_cast<char>(0));
-                    descriptionChanged = false;
+                    changed &= ~OPTION_DESCRIPTION;
                 }
 
 
                 // tags
-                if (hasTags) {
+                if (has & OPTION_TAGS) {
 
-                    if (all || tagsChanged) {
+                    if (all || (changed & OPTION_TAGS)) {
                         out.write(static_cast<char>(PARAMETER_OPTIONS_TAGS));
-                        out.writeTinyString(tags);
-
-                        if (!all) {
-                            tagsChanged = false;
-                        }
+                        out.writeTinyString(meta ? meta->tags.str() : empty_string);
                     }
-                } else if (tagsChanged) {
+                } else if (changed & OPTION_TAGS) {
 
                     out.write(static_cast<char>(PARAMETER_OPTIONS_TAGS));
                     out.writeTinyString("");
-                    tagsChanged = false;
+                    changed &= ~OPTION_TAGS;
                 }
 
                 // order
-                if (hasOrder) {
+                if (has & OPTION_ORDER) {
 
-                    if (all || orderChanged) {
+                    if (all || (changed & OPTION_ORDER)) {
                         out.write(static_cast<char>(PARAMETER_OPTIONS_ORDER));
                         out.write(order);
-
-                        if (!all) {
-                            orderChanged = false;
-                        }
                     }
-                } else if (orderChanged) {
+                } else if (changed & OPTION_ORDER) {
 
                     out.write(static_cast<char>(PARAMETER_OPTIONS_ORDER));
                     out.write(static_cast<int32_t>(0));
-                    orderChanged = false;
+                    changed &= ~OPTION_ORDER;
                 }
 
 
                 // parent id
                 if (std::shared_ptr<GroupParameter> p = parent.lock()) {
 
-                    if (all || parentChanged) {
+                    if (all || (changed & OPTION_PARENT)) {
                         out.write(static_cast<char>(PARAMETER_OPTIONS_PARENTID));
 
                         // cast to IParameter* due to incomplete type
                         out.write(((IParameter*)p.get())->getId());
-
-                        if (!all) {
-                            parentChanged = false;
-                        }
                     }
-                } else if (parentChanged) {
+                } else if (changed & OPTION_PARENT) {
 
                     out.write(static_cast<char>(PARAMETER_OPTIONS_PARENTID));
                     out.write(static_cast<int16_t>(0));
-                    parentChanged = false;
+                    changed &= ~OPTION_PARENT;
                 }
 
 
                 // TODO: widget
 
                 // userdata
-                if (userdata.size() > 0) {
+                if (meta && meta->userdata.size() > 0) {
 
-                    if (all || userdataChanged) {
+                    if (all || (changed & OPTION_USERDATA)) {
                         out.write(static_cast<char>(PARAMETER_OPTIONS_USERDATA));
-                        out.write(&userdata[0], userdata.size());
-
-                        if (!all) {
-                            userdataChanged = false;
-                        }
+                        out.write(&meta->userdata[0], meta->userdata.size());
                     }
-                } else if (userdataChanged) {
+                } else if (changed & OPTION_USERDATA) {
 
                     out.write(static_cast<char>(PARAMETER_OPTIONS_USERDATA));
                     out.write(static_cast<uint32_t>(0));
-                    userdataChanged = false;
+                    changed &= ~OPTION_USERDATA;
                 }
 
 
                 // userid
-                if (hasUserid) {
+                if (has & OPTION_USERID) {
 
-                    if (all || useridChanged) {
+                    if (all || (changed & OPTION_USERID)) {
                         out.write(static_cast<char>(PARAMETER_OPTIONS_USERID));
-                        out.writeTinyString(userid);
-
-                        if (!all) {
-                            useridChanged = false;
-                        }
+                        out.writeTinyString(meta ? meta->userid.str() : empty_string);
                     }
-                } else if (useridChanged) {
+                } else if (changed & OPTION_USERID) {
 
                     out.write(static_cast<char>(PARAMETER_OPTIONS_USERID));
                     out.writeTinyString("");
-                    useridChanged = false;
+                    changed &= ~OPTION_USERID;
                 }
 
 
                 // readonly
-                if (hasReadonly) {
+                if (has & OPTION_READONLY) {
 
-                    if (all || readonlyChanged) {
+                    if (all || (changed & OPTION_READONLY)) {
                         out.write(static_cast<char>(PARAMETER_OPTIONS_READONLY));
                         out.write(readonly);
-
-                        if (!all) {
-                            readonlyChanged = false;
-                        }
                     }
-                } else if (readonlyChanged) {
+                } else if (changed & OPTION_READONLY) {
 
                     out.write(static_cast<char>(PARAMETER_OPTIONS_READONLY));
                     out.write(false);
-                    readonlyChanged = false;
+                    changed &= ~OPTION_READONLY;
+                }
+
+                // a full write keeps other changes for the next update
+                if (!all) {
+                    changed = 0;
                 }
             }
 
@@ -910,42 +986,22 @@ namespace rcp {
 
             // mandatory
             int16_t parameter_id;
-            TD typeDefinition;
-
-            // optional fields
-            std::string label{};
-            std::map<std::string, std::string> languageLabel;
-            bool hasLabel;
-            bool labelChanged;
 
-            std::string description{};
-            std::map<std::string, std::string> languageDescription;
-            bool hasDescription;
-            bool descriptionChanged;
-
-            std::string tags{};
-            bool hasTags;
-            bool tagsChanged;
+            // OPTION_ bits
+            uint16_t has;
+            uint16_t changed;
 
             int32_t order{};
-            bool hasOrder;
-            bool orderChanged;
+            bool readonly{};
 
-            std::weak_ptr<GroupParameter> parent;
-            bool parentChanged;
+            TD typeDefinition;
 
+            // optional fields
+            InternedString label;
+            std::weak_ptr<GroupParameter> parent;
             //TODO: PARAMETER_WIDGET
 
-            std::vector<char> userdata;
-            bool userdataChanged;
-
-            std::string userid{};
-            bool hasUserid;
-            bool useridChanged;
-
-            bool readonly{};
-            bool hasReadonly;
-            bool readonlyChanged;
+            std::unique_ptr<Metadata> meta;
 
             std::vector< std::shared_ptr<UpdateEventHolder> > updatedCallbacks;
 
@@ -958,6 +1014,25 @@ namespace rcp {
         Parameter(std::shared_ptr<Value> obj) :
             obj(obj)
         {}
+
+        // Value and the value of a derived parameter share one pooled block
+        template<typename Extra>
+        struct Block {
+            Block(int16_t id, const TD& td) :
+                value(id, td)
+            {}
+
+            Value value;
+            Extra extra;
+        };
+
+        template<typename Extra>
+        Parameter(int16_t id, std::shared_ptr<Extra>& extra)
+        {
+            auto block = make_pooled< Block<Extra> >(id, TD(*this));
+            obj = std::shared_ptr<Value>(block, &block->value);
+            extra = std::shared_ptr<Extra>(block, &block->extra);
+        }
     };
 
 
@@ -984,8 +1059,11 @@ namespace rcp {
     class ValueParameter : public Parameter<TD>, public IValueParameter<T, TD>
     {
     public:
+        static const datatype_t DATATYPE = type_id;
+        typedef T value_type;
+
         static std::shared_ptr< ValueParameter<T, TD, type_id> > create(int16_t id) {
-            return std::make_shared< ValueParameter<T, TD, type_id> >(id);
+            return make_pooled< ValueParameter<T, TD, type_id> >(id);
         }
 
 
@@ -995,21 +1073,18 @@ namespace rcp {
         {}
 
         ValueParameter(int16_t id) :
-            Parameter<TD>(id)
-          , obj(std::make_shared<Value>())
+            ValueParameter(id, std::shared_ptr<Value>())
         {}
 
         ValueParameter(int16_t id, T& init) :
-            Parameter<TD>(id)
-          , obj(std::make_shared<Value>())
+            ValueParameter(id, std::shared_ptr<Value>())
         {
             obj->hasValue = true;
             obj->value = init;
         }
 
         ValueParameter(int16_t id, const T& init) :
-            Parameter<TD>(id)
-          , obj(std::make_shared<Value>())
+            ValueParameter(id, std::shared_ptr<Value>())
         {
             obj->hasValue = true;
             obj->value = init;
@@ -1020,19 +1095,17 @@ namespace rcp {
 
 
         virtual ParameterPtr newReference() {
-            return std::make_shared<ValueParameter<T, TD, type_id> >(*this);
+            return make_pooled<ValueParameter<T, TD, type_id> >(*this);
         }
 
         //------------------------------------
         // implement writeable
         virtual void write(Writer& out, bool all) {
 
-            if (onlyValueChanged())
+            // a full write never uses updatevalue data
+            if (!all && onlyValueChanged())
             {
-                // write updatevalue data
-                out.write(Parameter<TD>::getId());
-                getTypeDefinition().writeMandatory(out);
-                obj->writeValue(out);
+                writeUpdateValue(out);
             }
             else
             {
@@ -1049,6 +1122,11 @@ namespace rcp {
 
         }
 
+        // updatevalue data: id, mandatory typedefinition, value
+        virtual void writeUpdateValue(BufferWriter& out) {
+            writeUpdateValue(out, std::integral_constant<bool, (fixedValueSize(type_id) > 0)>());
+        }
+
         virtual void dump() {
             Parameter<TD>::dump();
 
@@ -1060,16 +1138,25 @@ namespace rcp {
         // iparameter
         bool isValueParameter() { return true; }
 
-        virtual bool handleOption(const parameter_options_t& opt, std::istream& is) {
+        // one address per value parameter type
+        static const void* valueTypeKey() {
+            static const char key = 0;
+            return &key;
+        }
+
+        virtual const void* getValueTypeKey() const {
+            return valueTypeKey();
+        }
+
+        virtual bool handleOption(const parameter_options_t& opt, BufferReader& is) {
 
             if (opt == PARAMETER_OPTIONS_VALUE) {
 
-                // read options
-                T val = getDefaultTypeDefinition().readValue(is);
+                // read straight into the value
+                getDefaultTypeDefinition().readValueInto(is, obj->value);
                 CHECK_STREAM_RETURN(false)
 
                 obj->hasValue = true;
-                obj->value = val;
                 return true;
             }
 
@@ -1092,6 +1179,35 @@ namespace rcp {
             obj->valueChanged = true;
             setDirty();
         }
+        void setValue(T&& value) {
+
+            obj->hasValue = true;
+
+            if (obj->value == value) {
+                return;
+            }
+
+            obj->value = std::move(value);
+            obj->valueChanged = true;
+            setDirty();
+        }
+
+        // set a string value from a buffer, reuses the memory of the current value
+        template<class Q = T>
+        typename std::enable_if<std::is_same<Q, std::string>::value>::type
+        setValue(const char* data, size_t size) {
+
+            obj->hasValue = true;
+
+            if (obj->value.size() == size &&
+                    obj->value.compare(0, size, data, size) == 0) {
+                return;
+            }
+
+            obj->value.assign(data, size);
+            obj->valueChanged = true;
+            setDirty();
+        }
         virtual bool hasValue() const { return obj->hasValue; }
         virtual void clearValue() {
             obj->hasValue = false;
@@ -1224,9 +1340,9 @@ namespace rcp {
             }
 
             // update value
-            auto v_other = std::dynamic_pointer_cast<ValueParameter<T, TD, type_id> >(other);
-            if (v_other)
+            if (other->getValueTypeKey() == getValueTypeKey())
             {
+                auto v_other = static_cast<ValueParameter<T, TD, type_id>*>(other.get());
                 if (v_other->hasValue())
                 {
                     setValue(v_other->getValue());
@@ -1251,7 +1367,7 @@ namespace rcp {
                 }
             }
 
-            ValueUpdateEventHolderPtr event = std::make_shared<ValueUpdateEventHolder>(func);
+            ValueUpdateEventHolderPtr event = make_pooled<ValueUpdateEventHolder>(func);
             obj->valueUpdatedCallbacks.push_back(std::move(event));
             return obj->valueUpdatedCallbacks.back()->callback;
         }
@@ -1265,7 +1381,7 @@ namespace rcp {
                 }
             }
 
-            ValueUpdateEventHolderPtr event = std::make_shared<ValueUpdateEventHolder>(func);
+            ValueUpdateEventHolderPtr event = make_pooled<ValueUpdateEventHolder>(func);
             obj->valueUpdatedCallbacks.push_back(std::move(event));
             return obj->valueUpdatedCallbacks.back()->callback;
         }
@@ -1291,10 +1407,32 @@ namespace rcp {
         friend class ParameterManager;
         friend class GroupParameter;
         friend class ParameterFactory;
+        template<typename> friend struct DatatypeThunks;
 
     protected:
         using Parameter<TD>::setDirty;
 
+        virtual bool updateValue(BufferReader& is) {
+
+            // read straight into the value, strings reuse their memory
+            bool changed = getDefaultTypeDefinition().readValueInto(is, obj->value);
+            CHECK_STREAM_RETURN(false)
+
+            obj->hasValue = true;
+
+            if (changed) {
+                obj->valueChanged = true;
+                setDirty();
+            }
+
+            if (obj->valueChanged)
+            {
+                obj->callValueUpdatedCb();
+            }
+
+            return true;
+        }
+
         virtual bool onlyValueChanged() const {
             return !Parameter<TD>::anyOptionChanged()
                     && !getTypeDefinition().anyOptionChanged()
@@ -1302,6 +1440,29 @@ namespace rcp {
         }
 
     private:
+        static constexpr size_t UPDATEVALUE_SIZE = sizeof(int16_t) + 1 + fixedValueSize(type_id);
+
+        // fixed-size value: one record, filled with plain stores
+        void writeUpdateValue(BufferWriter& out, std::true_type) {
+            char* p = out.grow(UPDATEVALUE_SIZE);
+            p = BufferWriter::store(p, Parameter<TD>::getId());
+            p = BufferWriter::store(p, static_cast<char>(type_id));
+            BufferWriter::store(p, obj->value);
+            obj->valueChanged = false;
+        }
+
+        void writeUpdateValue(BufferWriter& out, std::false_type) {
+            writeUpdateValue<BufferWriter>(out);
+        }
+
+        // with a final writer type the writes are not virtual
+        template<typename W>
+        void writeUpdateValue(W& out) {
+            out.write(Parameter<TD>::getId());
+            getTypeDefinition().writeMandatory(out);
+            out.write(obj->value);
+            obj->valueChanged = false;
+        }
 
         class ValueUpdateEventHolder {
         public:
@@ -1363,6 +1524,12 @@ namespace rcp {
         ValueParameter(std::shared_ptr<Value> obj) :
             obj(obj)
         {}
+
+        // allocate value together with the parameter Value
+        ValueParameter(int16_t id, std::shared_ptr<Value>&& value) :
+            Parameter<TD>(id, value)
+          , obj(std::move(value))
+        {}
     };
 
 
@@ -1382,8 +1549,10 @@ namespace rcp {
     public:
 //        template<typename> friend class Parameter;
 
+        static const datatype_t DATATYPE = DATATYPE_GROUP;
+
         static GroupParameterPtr create(int16_t id) {
-            return std::make_shared<GroupParameter>(id);
+            return make_pooled<GroupParameter>(id);
         }
 
         GroupParameter(const GroupParameter& v)
@@ -1392,18 +1561,16 @@ namespace rcp {
         {}
 
         GroupParameter()
-            : Parameter<GroupTypeDefinition>(static_cast<int16_t>(0))
-            , obj(std::make_shared<Value>())
+            : GroupParameter(static_cast<int16_t>(0), std::shared_ptr<Value>())
         {}
 
         GroupParameter(int16_t id)
-            : Parameter<GroupTypeDefinition>(id)
-            , obj(std::make_shared<Value>())
+            : GroupParameter(id, std::shared_ptr<Value>())
         {}
 
 
         virtual ParameterPtr newReference() {
-            return std::make_shared<GroupParameter>(*this);
+            return make_pooled<GroupParameter>(*this);
         }
 
         //
@@ -1425,7 +1592,7 @@ namespace rcp {
     private:
 
 
-        std::map<short, ParameterPtr >& children() {
+        ParameterTable& children() {
             return obj->children;
         }
 
@@ -1434,7 +1601,7 @@ namespace rcp {
             Value()
             {}
 
-            std::map<short, ParameterPtr > children;
+            ParameterTable children;
         };
 
         std::shared_ptr<Value> obj;
@@ -1443,6 +1610,12 @@ namespace rcp {
             Parameter<GroupTypeDefinition>(static_cast<int16_t>(0))
           , obj(obj)
         {}
+
+        // allocate children together with the parameter Value
+        GroupParameter(int16_t id, std::shared_ptr<Value>&& value)
+            : Parameter<GroupTypeDefinition>(id, value)
+            , obj(std::move(value))
+        {}
     };
 
 
@@ -1465,43 +1638,43 @@ namespace rcp {
 
         if (other->hasLabel()) {
             setLabel(other->getLabel());
-            updated = obj->labelChanged;
+            updated = (obj->changed & OPTION_LABEL) != 0;
         }
 
         if (other->hasDescription()) {
             setDescription(other->getDescription());            
-            if (!updated) updated = obj->descriptionChanged;
+            if (!updated) updated = (obj->changed & OPTION_DESCRIPTION) != 0;
         }
 
         if (other->hasTags()) {
             setTags(other->getTags());
-            if (!updated) updated = obj->tagsChanged;
+            if (!updated) updated = (obj->changed & OPTION_TAGS) != 0;
         }
 
         if (other->hasOrder()) {
             setOrder(other->getOrder());
-            if (!updated) updated = obj->orderChanged;
+            if (!updated) updated = (obj->changed & OPTION_ORDER) != 0;
         }
 
         if (other->hasParent()) {
             std::shared_ptr<GroupParameter> p = other->getParent().lock();
             p->addChild(*this);
-            if (!updated) updated = obj->parentChanged;
+            if (!updated) updated = (obj->changed & OPTION_PARENT) != 0;
         }
 
         if (other->hasUserdata()) {
             setUserdata(other->getUserdata());
-            if (!updated) updated = obj->userdataChanged;
+            if (!updated) updated = (obj->changed & OPTION_USERDATA) != 0;
         }
 
         if (other->hasUserid()) {
             setUserid(other->getUserid());
-            if (!updated) updated = obj->useridChanged;
+            if (!updated) updated = (obj->changed & OPTION_USERID) != 0;
         }
 
         if (other->hasReadonly()) {
             setReadonly(other->getReadonly());
-            if (!updated) updated = obj->readonlyChanged;
+            if (!updated) updated = (obj->changed & OPTION_READONLY) != 0;
         }
 
         if (updated) {
@@ -1529,7 +1702,7 @@ namespace rcp {
         }
 
         obj->parent = parent;
-        obj->parentChanged = true;
+        obj->changed |= OPTION_PARENT;
         setDirty();
     }
 
@@ -1599,6 +1772,8 @@ namespace rcp {
     class BangParameter : public Parameter<BangTypeDefinition>
     {
     public:
+        static const datatype_t DATATYPE = DATATYPE_BANG;
+
         BangParameter(const BangParameter& v) :
             Parameter<BangTypeDefinition>(v)
         {}
@@ -37,6 +37,7 @@
 
 #include "specializetypes.h"
 #include "parameterfactory.h"
+#include "datatyperegistry.h"
 
 
 namespace rcp {
@@ -44,7 +45,7 @@ namespace rcp {
     class ParameterParser {
     public:
 
-        static ParameterPtr parseUpdateValue(std::istream& is) {
+        static ParameterPtr parseUpdateValue(BufferReader& is) {
 
             // read id
             int16_t parameter_id = 0;
@@ -57,10 +58,49 @@ namespace rcp {
                 return nullptr;
             }
 
-            return ParameterFactory::createParameterReadValue(parameter_id, type_id, is);
+            ParameterPtr param = ParameterFactory::createParameterReadValue(parameter_id, type_id, is);
+
+            if (is.fail()) {
+                // incomplete value
+                return nullptr;
+            }
+
+            return param;
+        }
+
+        // read updatevalue data and apply the value directly
+        // to the parameter in the manager without creating a new parameter.
+        // returns false if the value can not be applied in place
+        static bool applyUpdateValue(BufferReader& is, IParameterManager& manager) {
+
+            // read id
+            int16_t parameter_id = 0;
+            parameter_id = readFromStream(is, parameter_id);
+
+            // get parameter type_id
+            datatype_t type_id = static_cast<datatype_t>(is.get());
+
+            // bang, group and range have no entry to apply a value
+            ApplyValueFn apply = DatatypeRegistry::get(type_id).applyValue;
+
+            if (is.eof() || !apply)
+            {
+                return false;
+            }
+
+            IParameter* param = manager.findParameter(parameter_id);
+
+            if (!param ||
+                param->getId() != parameter_id ||
+                param->getDatatype() != type_id)
+            {
+                return false;
+            }
+
+            return apply(*param, is);
         }
 
-        static ParameterPtr parse(std::istream& is, std::shared_ptr<IParameterManager> manager = nullptr) {
+        static ParameterPtr parse(BufferReader& is, const std::shared_ptr<IParameterManager>& manager = nullptr) {
 
             // get id and type            
             int16_t parameter_id = 0;
@@ -97,6 +137,8 @@ namespace rcp {
                     return nullptr;
                 }
 
+                // set before parsing, strings are shared through the manager
+                param->setManager(manager);
                 param->getTypeDefinition().parseOptions(is);
 
             } else if (type_id == DATATYPE_ARRAY) {
@@ -111,11 +153,11 @@ namespace rcp {
                     return nullptr;
                 }
 
+                param->setManager(manager);
                 param->getTypeDefinition().parseOptions(is);
             }
 
             if (param) {
-                param->setManager(manager);
                 param->parseOptions(is);
             }
 
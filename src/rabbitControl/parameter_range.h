@@ -63,6 +63,16 @@ namespace rcp {
         ~RangeParameter()
         {}
 
+        // range parameter of all element types share the datatype
+        static const void* valueTypeKey() {
+            static const char key = 0;
+            return &key;
+        }
+
+        virtual const void* getValueTypeKey() const {
+            return valueTypeKey();
+        }
+
         // IElementParameter
         virtual datatype_t getElementType() {
             return _RangeParameter::getDefaultTypeDefinition().getElementType().getDatatype();
@@ -1,6 +1,6 @@
 #include "parameterclient.h"
 
-#include "stringstreamwriter.h"
+#include "bufferwriter.h"
 #include "streamwriter.h"
 #include "rcp.h"
 
@@ -39,6 +39,19 @@ namespace rcp {
         m_transporter.send(data, 2);
     }
 
+    void ParameterClient::discover(short groupId) {
+
+        if (!m_transporter.isConnected()) {
+            return;
+        }
+
+        WriteablePtr id_data = IdData::create(groupId);
+        Packet packet(COMMAND_DISCOVER, id_data);
+        BufferWriter writer;
+        packet.write(writer, false);
+        m_transporter.send(writer.data(), static_cast<int>(writer.size()));
+    }
+
     // sending all dirty parameter to server!
     void ParameterClient::update() {
 
@@ -49,34 +62,33 @@ namespace rcp {
 		// protect lists to be used from multiple threads
 		m_parameterManager->lock();
 
+        // one buffer for all updates
+        BufferWriter writer;
+
         // send updates
+        m_parameterManager->collectDirtyParameter();
+
         for (auto& p : m_parameterManager->dirtyParameter) {
 
             // TODO: send COMMAND_UPDATEVALUE
             command_t cmd = COMMAND_UPDATE;
 
-            if (p.second->onlyValueChanged())
+            if (p->onlyValueChanged())
             {
                 cmd = COMMAND_UPDATEVALUE;
             }
 
-            Packet packet(cmd, p.second);
-
             // serialize
-            StringStreamWriter writer;
-            packet.write(writer, false);
-
-            std::istream& data = writer.getBuffer();
-
-            data.seekg (0, data.end);
-            long long length = data.tellg();
-            data.seekg (0, data.beg);
+            writer.clear();
 
-            char* d = new char[length];
-            data.read(d, length);
+            if (cmd == COMMAND_UPDATEVALUE) {
+                Packet::writeUpdateValue(writer, *p);
+            } else {
+                PacketView packet(cmd, *p);
+                packet.write(writer, false);
+            }
 
-            m_transporter.send(d, length);
-            delete []d;
+            m_transporter.send(writer.data(), static_cast<int>(writer.size()));
         }
         m_parameterManager->dirtyParameter.clear();
 
@@ -86,24 +98,64 @@ namespace rcp {
     // interface ClientTransporterListener
     void ParameterClient::connected() {
 
+        // known with the server's info
+        m_serverAcceptsSubscriptions = false;
+
         // request version
         char data[2];
         data[0] = 0x01;
         data[1] = 0x00;
         m_transporter.send(data, 2);
 
+        if (m_lazyDiscovery) {
+            // top level parameter only
+            discover(0);
+            return;
+        }
+
         // send initialize command
         initialize();
     }
 
     void ParameterClient::disconnected()
     {
+        m_serverAcceptsSubscriptions = false;
         m_parameterManager->clear();
     }
 
-    void ParameterClient::received(std::istream& data)
+    void ParameterClient::received(const char* data, size_t size)
+    {
+        BufferReader reader(data, size);
+
+        // a message may contain multiple packets
+        do {
+            if (!_received(reader)) {
+                // parsing error??
+                for (const auto& kv : parsing_error_cb) {
+                    (kv.first->*kv.second)();
+                }
+                return;
+            }
+        } while (reader.remaining() > 0);
+    }
+
+    bool ParameterClient::_received(BufferReader& reader)
     {
-        auto packet = rcp::Packet::parse(data, m_parameterManager);
+        // apply updatevalue in place
+        if (reader.peek() == COMMAND_UPDATEVALUE)
+        {
+            BufferReader value_reader(reader.data() + reader.position() + 1, reader.remaining() - 1);
+
+            if (ParameterParser::applyUpdateValue(value_reader, *m_parameterManager))
+            {
+                reader.skip(1 + value_reader.position());
+                return true;
+            }
+        }
+
+        // parsed parameter are allocated from the manager's pool
+        ParameterPool::Scope scope(m_parameterManager->pool);
+        auto packet = rcp::Packet::parse(reader, m_parameterManager);
         if (packet.hasValue()) {
 
             rcp::Packet& the_packet = packet.getValue();
@@ -137,14 +189,11 @@ namespace rcp {
                 std::cerr << "got invalid command!\n";
                 break;
             }
+
+            return true;
         }
-        else
-        {
-            // parsing error??
-            for (const auto& kv : parsing_error_cb) {
-                (kv.first->*kv.second)();
-            }
-        }
+
+        return false;
     }
 
     void ParameterClient::_version(Packet& packet) {
@@ -155,14 +204,64 @@ namespace rcp {
             if (info_data) {
                 std::cout << "version: " << info_data->getVersion() << std::endl;
                 std::cout << "applicationid: " << info_data->getApplicationId() << std::endl;
+
+                // older servers would misread subscriptions
+                m_serverAcceptsSubscriptions = info_data->getAcceptsSubscriptions();
             }
         } else {
             // no data, respond with version
-            WriteablePtr version = InfoData::create(RCP_SPECIFICATION_VERSION, m_applicationId);
-            Packet resp_packet(COMMAND_INFO, version);
-            StringStreamWriter writer;
-            resp_packet.write(writer, false);
-            m_transporter.send(writer.getBuffer());
+            _sendInfo();
+        }
+    }
+
+    void ParameterClient::_sendInfo() {
+
+        InfoDataPtr info_data = InfoData::create(RCP_SPECIFICATION_VERSION, m_applicationId);
+        // we parse all packets of a message
+        info_data->setMultiPacket(true);
+
+        if (m_serverAcceptsSubscriptions) {
+            for (short group_id : m_subscriptions) {
+                info_data->addSubscription(group_id);
+            }
+        }
+
+        WriteablePtr version = info_data;
+        Packet resp_packet(COMMAND_INFO, version);
+        BufferWriter writer;
+        resp_packet.write(writer, false);
+        m_transporter.send(writer.data(), static_cast<int>(writer.size()));
+    }
+
+    void ParameterClient::subscribe(short groupId) {
+
+        if (m_subscriptions.insert(groupId).second &&
+                m_serverAcceptsSubscriptions &&
+                m_transporter.isConnected()) {
+            _sendInfo();
+        }
+    }
+
+    void ParameterClient::unsubscribe(short groupId) {
+
+        if (m_subscriptions.erase(groupId) > 0 &&
+                m_serverAcceptsSubscriptions &&
+                m_transporter.isConnected()) {
+            _sendInfo();
+        }
+    }
+
+    void ParameterClient::clearSubscriptions() {
+
+        if (m_subscriptions.empty()) {
+            return;
+        }
+
+        m_subscriptions.clear();
+
+        if (m_serverAcceptsSubscriptions &&
+                m_transporter.isConnected()) {
+            _sendInfo();
         }
     }
 
@@ -177,12 +276,15 @@ namespace rcp {
         }
 
         // assume this is a parameter!!
-        rcp::ParameterPtr param = std::dynamic_pointer_cast<rcp::IParameter>(packet.getData());
-        if (param) {
+        const WriteablePtr& data = packet.getData();
+        if (IParameter* p = data->asParameter()) {
 
-            rcp::ParameterPtr chached_param = m_parameterManager->getParameter(param->getId());
+            // shares ownership with the packet data
+            rcp::ParameterPtr param(data, p);
 
-            if (rcp::ParameterManager::isValid(chached_param)) {
+            rcp::IParameter* chached_param = m_parameterManager->findParameter(param->getId());
+
+            if (chached_param) {
 
                 // got it... update it
                 chached_param->update(param);
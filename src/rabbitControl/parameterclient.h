@@ -1,6 +1,8 @@
 #ifndef PARAMETERCLIENT_H
 #define PARAMETERCLIENT_H
 
+#include <set>
+
 #include "packet.h"
 #include "clienttransporter.h"
 #include "parametermanager.h"
@@ -27,6 +29,17 @@ namespace rcp {
         void disconnect();
 
         void initialize(); // tries to send an init-command
+        void discover(short groupId); // request the children of a group
+
+        // on connect only discover the top level parameter
+        // instead of initializing the whole tree.
+        // children of groups are requested with discover
+        void setLazyDiscovery(bool lazy) {
+            m_lazyDiscovery = lazy;
+        }
+        bool getLazyDiscovery() const {
+            return m_lazyDiscovery;
+        }
         void update(); // update all changes
 
         // connect to events
@@ -55,7 +68,8 @@ namespace rcp {
         // interface ClientTransporterListener
         virtual void connected();
         virtual void disconnected();
-        virtual void received(std::istream& data);
+        virtual void received(const char* data, size_t size);
+        using ClientTransporterListener::received;
 
         void setApplicationId(const std::string& appid) {
             m_applicationId = appid;
@@ -64,10 +78,23 @@ namespace rcp {
             return m_applicationId;
         }
 
+        // only receive updates of subscribed groups and their children.
+        // without subscriptions all updates are received.
+        // subscriptions are only sent to servers announcing support,
+        // other servers send all updates
+        void subscribe(short groupId);
+        void unsubscribe(short groupId);
+        void clearSubscriptions();
+        const std::set<short>& getSubscriptions() const {
+            return m_subscriptions;
+        }
+
     private:
+        bool _received(BufferReader& reader);
         void _update(Packet& packet);
         void _remove(Packet& packet);
         void _version(Packet& packet);
+        void _sendInfo();
 
         std::shared_ptr<ParameterManager> m_parameterManager;
         ClientTransporter& m_transporter;
@@ -80,6 +107,9 @@ namespace rcp {
 //        statusChanged(Status status, String message);
 
         std::string m_applicationId;
+        std::set<short> m_subscriptions;
+        bool m_serverAcceptsSubscriptions{false};
+        bool m_lazyDiscovery{false};
     };
 
 }
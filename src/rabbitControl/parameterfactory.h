@@ -48,13 +48,13 @@ namespace rcp {
     {
     public:
         template<typename T>
-        static ParameterPtr readValue(const T& p, std::istream& is) {
+        static ParameterPtr readValue(const T& p, BufferReader& is) {
             p->setValue(p->getDefaultTypeDefinition().readValue(is));
             return p;
         }
 
         static ParameterPtr createParameter(int16_t parameter_id, datatype_t type_id);
-        static ParameterPtr createParameterReadValue(int16_t parameter_id, datatype_t type_id, std::istream& is);
+        static ParameterPtr createParameterReadValue(int16_t parameter_id, datatype_t type_id, BufferReader& is);
 
 
         template<typename T>
@@ -63,7 +63,7 @@ namespace rcp {
         }
 
         static ParameterPtr createRangeParameter(int16_t parameter_id, datatype_t type_id);
-        static ParameterPtr createRangeParameterReadValue(int16_t parameter_id, datatype_t type_id, std::istream& is);
+        static ParameterPtr createRangeParameterReadValue(int16_t parameter_id, datatype_t type_id, BufferReader& is);
     };
 
 }
@@ -37,12 +37,17 @@
 
 namespace rcp {
 
-    ParameterManager::ParameterManager() {
+    ParameterManager::ParameterManager() :
+        pool(ParameterPool::create())
+    {
     }
 
     ParameterManager::~ParameterManager() {
         params.clear();
         ids.clear();
+
+        // deleted when the last parameter is gone
+        pool->release();
     }
 
     void ParameterManager::removeParameter(IParameter& parameter) {
@@ -53,26 +58,23 @@ namespace rcp {
 
         if (id == 0) return;
 
-        auto it = params.find(id);
-        if (it == params.end()) {
+        ParameterPtr parameter = params.get(id);
+        if (!parameter) {
             return;
         }
 
         // add it to removed
-        setParameterRemoved(params[id]);
+        setParameterRemoved(parameter);
 
-        removeParameterDirect(params[id]);
+        removeParameterDirect(parameter);
     }
 
     void ParameterManager::removeParameterDirect(ParameterPtr& parameter) {
 
         if (!isValid(*parameter)) return;
 
-        // erase from available ids
-        auto id_it = std::find(ids.begin(), ids.end(), parameter->getId());
-        if (id_it != ids.end()) {
-            ids.erase(id_it);
-        } else {
+        // release id
+        if (!ids.release(parameter->getId())) {
             std::cerr << "ParameterManager::removeParameterDirect - could not find id in id list\n";
         }
 
@@ -86,7 +88,9 @@ namespace rcp {
         if (parameter->getTypeDefinition().getDatatype() == DATATYPE_GROUP) {
             GroupParameterPtr gp = std::dynamic_pointer_cast<GroupParameter>(parameter);
             for (auto& child : gp->children()) {
-                removeParameterDirect(child.second);
+                // copy, removing the child clears its slot in children
+                ParameterPtr child_param = child.second;
+                removeParameterDirect(child_param);
             }
         }
     }
@@ -102,7 +106,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            BooleanParameterPtr p = std::make_shared<BooleanParameter>(id);
+            ParameterPool::Scope scope(pool);
+            BooleanParameterPtr p = make_pooled<BooleanParameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -117,7 +122,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            Int8ParameterPtr p = std::make_shared<Int8Parameter>(id);
+            ParameterPool::Scope scope(pool);
+            Int8ParameterPtr p = make_pooled<Int8Parameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -132,7 +138,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            Int16ParameterPtr p = std::make_shared<Int16Parameter>(id);
+            ParameterPool::Scope scope(pool);
+            Int16ParameterPtr p = make_pooled<Int16Parameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -147,7 +154,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            Int32ParameterPtr p = std::make_shared<Int32Parameter>(id);
+            ParameterPool::Scope scope(pool);
+            Int32ParameterPtr p = make_pooled<Int32Parameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -162,7 +170,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            Int64ParameterPtr p = std::make_shared<Int64Parameter>(id);
+            ParameterPool::Scope scope(pool);
+            Int64ParameterPtr p = make_pooled<Int64Parameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -177,7 +186,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            Float32ParameterPtr p = std::make_shared<Float32Parameter>(id);
+            ParameterPool::Scope scope(pool);
+            Float32ParameterPtr p = make_pooled<Float32Parameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -192,7 +202,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            Float64ParameterPtr p = std::make_shared<Float64Parameter>(id);
+            ParameterPool::Scope scope(pool);
+            Float64ParameterPtr p = make_pooled<Float64Parameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -208,7 +219,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            StringParameterPtr p = std::make_shared<StringParameter>(id);
+            ParameterPool::Scope scope(pool);
+            StringParameterPtr p = make_pooled<StringParameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -223,7 +235,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            RGBAParameterPtr p = std::make_shared<RGBAParameter>(id);
+            ParameterPool::Scope scope(pool);
+            RGBAParameterPtr p = make_pooled<RGBAParameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -238,7 +251,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            BangParameterPtr p = std::make_shared<BangParameter>(id);
+            ParameterPool::Scope scope(pool);
+            BangParameterPtr p = make_pooled<BangParameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -253,7 +267,8 @@ namespace rcp {
         short id = getNextId();
         if (id != 0)
         {
-            GroupParameterPtr p = std::make_shared<GroupParameter>(id);
+            ParameterPool::Scope scope(pool);
+            GroupParameterPtr p = make_pooled<GroupParameter>(id);
             _addParameterDirect(label, (ParameterPtr&)p, group);
 
             return p;
@@ -267,36 +282,29 @@ namespace rcp {
 
     ParameterPtr ParameterManager::getParameter(const short& id)
     {
-        auto it = params.find(id);
+        ParameterPtr parameter = params.get(id);
 
-        if (it != params.end())
+        if (parameter)
         {
-            return it->second;
+            return parameter;
         }
 
         return std::make_shared<InvalidParameter>(0);
     }
 
+    IParameter* ParameterManager::findParameter(short id)
+    {
+        return params.find(id);
+    }
+
 
 // private functions
 
 
     short ParameterManager::getNextId()
     {
-        for (unsigned short i=1; i<USHRT_MAX; i++)
-        {
-            auto search = ids.find(static_cast<short>(i));
-
-            if (search == ids.end())
-            {
-                short i_s = static_cast<short>(i);
-                ids.insert(i_s);
-                return i_s;
-            }
-        }
-
-        // return invalid id 0
-        return 0;
+        // returns invalid id 0 if all ids are taken
+        return ids.allocate();
     }
 
 
@@ -308,21 +316,17 @@ namespace rcp {
     void ParameterManager::_addParameter(ParameterPtr& parameter) {
 
         // check if already in map
-        auto it = params.find(parameter->getId());
-        if (it != params.end()) {
+        if (params.contains(parameter->getId())) {
             // already in map... ignore
             return;
         }
 
         // need to reserve id
-        if (std::find(ids.begin(), ids.end(), parameter->getId()) != ids.end()) {
+        if (!ids.reserve(parameter->getId())) {
             // huh - parameter is not in parameter cache, but id already taken!?
             std::cerr << "inconsistency in id/parameter list\n";
         }
 
-        // in any case: reserve that id
-        ids.insert(parameter->getId());
-
         // add it
         parameter->setManager(getShared());
         // called from client - parameter are clean by default
@@ -334,7 +338,7 @@ namespace rcp {
             parent->addChild(parameter);
         }
 
-        params[parameter->getId()] = parameter;
+        params.set(parameter->getId(), parameter);
     }
 
     /**
@@ -345,16 +349,14 @@ namespace rcp {
      */
     void ParameterManager::_addParameter(ParameterPtr& parameter, GroupParameterPtr& group) {
 
-        auto it = params.find(parameter->getId());
-        if (it == params.end()) {
+        if (!params.contains(parameter->getId())) {
 
-            params[parameter->getId()] = parameter;
+            params.set(parameter->getId(), parameter);
 
             // check?
-            if (std::find(ids.begin(), ids.end(), parameter->getId()) != ids.end()) {
+            if (!ids.reserve(parameter->getId())) {
                 std::cout << "consistency in id/parameter list\n";
             }
-            ids.insert(parameter->getId());
         } else {
             // already in there!!
             std::cout << "param already in map: " << parameter->getId() << "\n";
@@ -372,8 +374,12 @@ namespace rcp {
      * @param group
      */
     void ParameterManager::_addParameterDirect(const std::string& label, ParameterPtr& parameter, GroupParameterPtr& group) {
+        _addParameterDirect(label, parameter, group, getShared());
+    }
+
+    void ParameterManager::_addParameterDirect(const std::string& label, ParameterPtr& parameter, GroupParameterPtr& group, const std::shared_ptr<IParameterManager>& manager) {
 
-        parameter->setManager(getShared());        
+        parameter->setManager(manager);
         parameter->setLabel(label);
 
         // called on server - parameters are dirty by default
@@ -384,25 +390,43 @@ namespace rcp {
         // add to group
         group->addChild(parameter);
 
-        params[parameter->getId()] = parameter;
+        params.set(parameter->getId(), parameter);
+    }
+
+    // grow parameter table and group children before exposing count parameter
+    void ParameterManager::reserve(size_t count, GroupParameterPtr& group) {
+        lock();
+        params.reserve(count);
+        group->children().reserve(count);
+        unlock();
     }
 
 
     void ParameterManager::setParameterDirty(IParameter& parameter)
 	{
-#ifndef RCP_MANAGER_NO_LOCKING
-		// protect lists to be used from multiple threads
-		std::lock_guard<std::mutex> lock(m_mutex);
-#endif
-		
-        // only add if not already removed
-        if (removedParameter.find(parameter.getId()) != removedParameter.end()) {
-            // parameter is removed, don't add
-            std::cout << "parameter going to be removed: " << parameter.getId() << "\n";
-            return;
-        }
+        // lock-free: may be called from any thread
+        // removed parameter are skipped in collectDirtyParameter
+        dirtySet.set(parameter.getId());
+    }
 
-        dirtyParameter[parameter.getId()] = parameter.newReference();
+    void ParameterManager::collectDirtyParameter()
+    {
+        // call with lock held
+        dirtyIds.clear();
+        dirtySet.drain(dirtyIds);
+
+        for (short id : dirtyIds) {
+
+            // only add if not removed
+            if (removedParameter.contains(id)) {
+                continue;
+            }
+
+            ParameterPtr parameter = params.get(id);
+            if (parameter) {
+                dirtyParameter.push_back(parameter);
+            }
+        }
     }
 
     void ParameterManager::setParameterRemoved(ParameterPtr& parameter)
@@ -412,14 +436,10 @@ namespace rcp {
 		std::lock_guard<std::mutex> lock(m_mutex);
 #endif
 		
-        // check if parameter is dirty...
-        auto it = dirtyParameter.find(parameter->getId());
-        if (it != dirtyParameter.end()) {
-            // remove parameter from dirties
-            dirtyParameter.erase(it);
-        }
+        // remove parameter from dirties
+        dirtySet.reset(parameter->getId());
 
-        removedParameter[parameter->getId()] = parameter;
+        removedParameter.set(parameter->getId(), parameter);
     }
 
     void ParameterManager::clear()
@@ -431,6 +451,7 @@ namespace rcp {
 		
         ids.clear();
         params.clear();
+        dirtySet.clear();
         dirtyParameter.clear();
         removedParameter.clear();
     }
@@ -39,8 +39,8 @@
 
 #include <map>
 #include <vector>
-#include <unordered_set>
 #include <climits>
+#include <stdexcept>
 
 #ifndef RCP_MANAGER_NO_LOCKING
 #include <mutex>
@@ -49,6 +49,10 @@
 #include "parameter_intern.h"
 #include "parameterfactory.h"
 #include "iparametermanager.h"
+#include "idallocator.h"
+#include "parametertable.h"
+#include "dirtyset.h"
+#include "stringpool.h"
 
 namespace rcp {
 
@@ -93,6 +97,59 @@ public:
 
     GroupParameterPtr createGroupParameter(const std::string& label, GroupParameterPtr& group);
 
+    // create a parameter of any value type, e.g. createParameter<UInt16Parameter>
+    template<typename T>
+    std::shared_ptr<T> createParameter(const std::string& label, GroupParameterPtr& group) {
+        short id = getNextId();
+        if (id != 0)
+        {
+            ParameterPool::Scope scope(pool);
+            std::shared_ptr<T> p = make_pooled<T>(id);
+            _addParameterDirect(label, (ParameterPtr&)p, group);
+
+            return p;
+        }
+
+        throw std::runtime_error("no valid id...");
+    }
+
+    // create parameter of one value type for all labels in one go
+    template<typename T>
+    std::vector<std::shared_ptr<T> > createParameters(const std::vector<std::string>& labels, GroupParameterPtr& group) {
+
+        std::vector<std::shared_ptr<T> > created;
+        created.reserve(labels.size());
+
+        reserve(labels.size(), group);
+
+        std::shared_ptr<IParameterManager> manager = getShared();
+        ParameterPool::Scope scope(pool);
+
+        for (const std::string& label : labels) {
+
+            short id = getNextId();
+            if (id == 0) {
+                throw std::runtime_error("no valid id...");
+            }
+
+            std::shared_ptr<T> p = make_pooled<T>(id);
+            _addParameterDirect(label, (ParameterPtr&)p, group, manager);
+            created.push_back(p);
+        }
+
+        return created;
+    }
+
+    // make room for count more parameter in group
+    void reserve(size_t count, GroupParameterPtr& group);
+
+    // number of distinct labels, tags, units, ... in use
+    size_t getInternedCount() const { return strings.size(); }
+
+    // number of released ids to keep before reusing an id
+    void setIdQuarantine(size_t count) { ids.setQuarantine(count); }
+    size_t getIdQuarantine() const { return ids.getQuarantine(); }
+
 
     template<typename> friend class Parameter;
     friend class ParameterServer;
@@ -102,10 +159,35 @@ public:
 public:
 	// IParameterManager
 	virtual ParameterPtr getParameter(const short& id) override;
+    // non-owning lookup, returns nullptr if id is unknown
+    // the pointer is valid until the parameter is removed
+    virtual IParameter* findParameter(short id) override;
+
+    // typed lookup, returns nullptr if id is unknown or of another type
+    // the value type key tells range and custom parameter apart
+    template<typename T>
+    T* get(short id) {
+        IParameter* parameter = params.find(id);
+        if (parameter &&
+                parameter->getDatatype() == T::DATATYPE &&
+                parameter->getValueTypeKey() == T::valueTypeKey()) {
+            return static_cast<T*>(parameter);
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    std::shared_ptr<T> getShared(short id) {
+        if (get<T>(id)) {
+            return std::static_pointer_cast<T>(params.get(id));
+        }
+        return nullptr;
+    }
 private:
 	// IParameterManager
 	virtual void setParameterDirty(IParameter& parameter) override;
 	virtual void setParameterRemoved(ParameterPtr& parameter) override;
+    virtual InternedString intern(const std::string& str) override { return strings.intern(str); }
 	
 	
 private:
@@ -114,14 +196,26 @@ private:
     void _addParameter(ParameterPtr& parameter);
     void _addParameter(ParameterPtr& parameter, GroupParameterPtr& group);
     void _addParameterDirect(const std::string& label, ParameterPtr& parameter, GroupParameterPtr& group);
+    void _addParameterDirect(const std::string& label, ParameterPtr& parameter, GroupParameterPtr& group, const std::shared_ptr<IParameterManager>& manager);
 	void removeParameterDirect(ParameterPtr& parameter);
     void clear();
+    void collectDirtyParameter();
 
     //--------
-    std::unordered_set<short> ids;
-    std::map<short, ParameterPtr > params;
-    std::map<short, ParameterPtr > dirtyParameter;
-    std::map<short, ParameterPtr > removedParameter;
+    IdAllocator ids;
+    // backs parameter created by this manager
+    ParameterPool* pool;
+    ParameterTable params;
+    ParameterTable removedParameter;
+
+    // labels, tags, units, ... shared by all parameter
+    StringPool strings;
+
+    // ids of dirty parameter, set without locking
+    DirtySet dirtySet;
+    // filled by collectDirtyParameter
+    std::vector<ParameterPtr> dirtyParameter;
+    std::vector<short> dirtyIds;
 	
 private:
 	void lock();
@@ -0,0 +1,160 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#include "parameterpool.h"
+
+#include <new>
+
+namespace rcp {
+
+    ParameterPool*& ParameterPool::current()
+    {
+        static thread_local ParameterPool* pool = nullptr;
+        return pool;
+    }
+
+    ParameterPool::ParameterPool() :
+        m_chunkPos(nullptr)
+      , m_chunkEnd(nullptr)
+      , m_blocks(0)
+      , m_released(false)
+    {
+        for (auto& f : m_free) {
+            f = nullptr;
+        }
+    }
+
+    ParameterPool::~ParameterPool()
+    {
+        for (char* c : m_chunks) {
+            ::operator delete(c);
+        }
+    }
+
+    void ParameterPool::release()
+    {
+        bool unused = false;
+        {
+#ifndef RCP_MANAGER_NO_LOCKING
+            std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+            m_released = true;
+            unused = (m_blocks == 0);
+        }
+
+        if (unused) {
+            delete this;
+        }
+    }
+
+    void* ParameterPool::allocate(size_t size)
+    {
+        if (size == 0) {
+            size = 1;
+        }
+
+        size_t index = (size - 1) / ALIGN;
+        size_t block_size = (index + 1) * ALIGN;
+
+#ifndef RCP_MANAGER_NO_LOCKING
+        std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+
+        m_blocks++;
+
+        if (size > MAX_BLOCK) {
+            return ::operator new(size);
+        }
+
+        // reuse a freed block
+        if (m_free[index] != nullptr) {
+            FreeBlock* block = m_free[index];
+            m_free[index] = block->next;
+            return block;
+        }
+
+        // cut from chunk
+        if (m_chunkPos == nullptr ||
+            static_cast<size_t>(m_chunkEnd - m_chunkPos) < block_size)
+        {
+            char* chunk = static_cast<char*>(::operator new(CHUNK_SIZE));
+            m_chunks.push_back(chunk);
+            m_chunkPos = chunk;
+            m_chunkEnd = chunk + CHUNK_SIZE;
+        }
+
+        void* p = m_chunkPos;
+        m_chunkPos += block_size;
+        return p;
+    }
+
+    void ParameterPool::deallocate(void* p, size_t size)
+    {
+        if (p == nullptr) {
+            return;
+        }
+
+        if (size == 0) {
+            size = 1;
+        }
+
+        bool unused = false;
+        {
+#ifndef RCP_MANAGER_NO_LOCKING
+            std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+
+            if (size > MAX_BLOCK) {
+                ::operator delete(p);
+            } else {
+                FreeBlock* block = static_cast<FreeBlock*>(p);
+                size_t index = (size - 1) / ALIGN;
+                block->next = m_free[index];
+                m_free[index] = block;
+            }
+
+            m_blocks--;
+            unused = (m_released && m_blocks == 0);
+        }
+
+        if (unused) {
+            delete this;
+        }
+    }
+
+    size_t ParameterPool::getCapacity() const
+    {
+        return m_chunks.size() * CHUNK_SIZE;
+    }
+}
@@ -0,0 +1,178 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_PARAMETERPOOL_H
+#define RCP_PARAMETERPOOL_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#ifndef RCP_MANAGER_NO_LOCKING
+#include <mutex>
+#endif
+
+namespace rcp {
+
+    /*
+     * ParameterPool is a size-class allocator for parameter state.
+     * blocks are cut from large chunks, freed blocks are kept in
+     * per size free-lists and reused.
+     * objects created with make_pooled while a pool is current
+     * are allocated from it.
+     * the owner calls release(), the pool is deleted
+     * once the owner and all blocks are gone.
+    */
+    class ParameterPool
+    {
+    public:
+        static ParameterPool* create() {
+            return new ParameterPool();
+        }
+
+        // the pool used by make_pooled on this thread, or nullptr
+        static ParameterPool*& current();
+
+        // makes a pool current on this thread for its lifetime
+        class Scope
+        {
+        public:
+            Scope(ParameterPool* pool) :
+                m_previous(current())
+            {
+                current() = pool;
+            }
+            ~Scope() {
+                current() = m_previous;
+            }
+        private:
+            ParameterPool* m_previous;
+        };
+
+    public:
+        void release();
+
+        void* allocate(size_t size);
+        void deallocate(void* p, size_t size);
+
+        // number of bytes held in chunks
+        size_t getCapacity() const;
+
+    private:
+        ParameterPool();
+        ~ParameterPool();
+        ParameterPool(const ParameterPool&) = delete;
+        ParameterPool& operator=(const ParameterPool&) = delete;
+
+        static const size_t ALIGN = 16;
+        static const size_t MAX_BLOCK = 512;
+        static const size_t CHUNK_SIZE = 64 * 1024;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        FreeBlock* m_free[MAX_BLOCK / ALIGN];
+        std::vector<char*> m_chunks;
+        char* m_chunkPos;
+        char* m_chunkEnd;
+
+        size_t m_blocks;
+        bool m_released;
+
+#ifndef RCP_MANAGER_NO_LOCKING
+        std::mutex m_mutex;
+#endif
+    };
+
+
+    // std allocator on a ParameterPool, uses the heap without pool
+    template<typename T>
+    class PoolAllocator
+    {
+    public:
+        typedef T value_type;
+
+        PoolAllocator(ParameterPool* pool) :
+            pool(pool)
+        {}
+
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>& other) :
+            pool(other.pool)
+        {}
+
+        T* allocate(size_t n) {
+            if (pool) {
+                return static_cast<T*>(pool->allocate(n * sizeof(T)));
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t n) {
+            if (pool) {
+                pool->deallocate(p, n * sizeof(T));
+            } else {
+                ::operator delete(p);
+            }
+        }
+
+        template<typename U>
+        bool operator==(const PoolAllocator<U>& other) const {
+            return pool == other.pool;
+        }
+
+        template<typename U>
+        bool operator!=(const PoolAllocator<U>& other) const {
+            return pool != other.pool;
+        }
+
+        ParameterPool* pool;
+    };
+
+
+    // object and control-block in one block of the current pool
+    template<typename T, typename... Args>
+    std::shared_ptr<T> make_pooled(Args&&... args) {
+
+        ParameterPool* pool = ParameterPool::current();
+        if (pool) {
+            return std::allocate_shared<T>(PoolAllocator<T>(pool), std::forward<Args>(args)...);
+        }
+
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+}
+
+#endif // RCP_PARAMETERPOOL_H
@@ -34,7 +34,11 @@
 
 #include "parameterserver.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "rcp.h"
+#include "bufferwriter.h"
 #include "streamwriter.h"
 #include "infodata.h"
 
@@ -68,13 +72,42 @@ namespace rcp {
 
     void ParameterServer::clear() {
         parameterManager->clear();
+
+        parameterManager->lock();
+        _clearInit();
+        m_updateRates.clear();
+        parameterManager->unlock();
     }
 
 
-    void ParameterServer::received(std::istream& data, ServerTransporter& transporter, void* id)
+    void ParameterServer::received(const char* data, size_t size, ServerTransporter& transporter, void* id)
     {
+        BufferReader reader(data, size);
+
+        // apply updatevalue in place
+        if (reader.peek() == COMMAND_UPDATEVALUE)
+        {
+            BufferReader value_reader(data + 1, size - 1);
+
+            if (ParameterParser::applyUpdateValue(value_reader, *parameterManager))
+            {
+                // a single updatevalue packet can be replaced by a newer value
+                short value_id = 0;
+                if (1 + value_reader.position() == size) {
+                    value_id = static_cast<short>((static_cast<uint8_t>(data[1]) << 8) | static_cast<uint8_t>(data[2]));
+                }
+
+                // send data to all clients
+                SharedBufferPtr buffer = SharedBuffer::create(data, size, value_id);
+                _forward(buffer, id, static_cast<short>((static_cast<uint8_t>(data[1]) << 8) | static_cast<uint8_t>(data[2])));
+                return;
+            }
+        }
+
         // parse data
-        Option<Packet> packet_option = Packet::parse(data, parameterManager);
+        // parsed parameter are allocated from the manager's pool
+        ParameterPool::Scope scope(parameterManager->pool);
+        Option<Packet> packet_option = Packet::parse(reader, parameterManager);
 
         if (packet_option.hasValue())
         {
@@ -91,9 +124,9 @@ namespace rcp {
             case COMMAND_UPDATE:
                 if (_update(the_packet, transporter, id)) {
                     // send data to all clients
-                    for (auto& transporter : transporterList) {
-                        transporter.get().sendToAll(data, id);
-                    }
+                    SharedBufferPtr buffer = SharedBuffer::create(data, size);
+                    IParameter* parameter = static_cast<IParameter*>(the_packet.getData().get());
+                    _forward(buffer, id, parameter->getId());
                 }
                 break;
 
@@ -103,7 +136,7 @@ namespace rcp {
                 break;
 
             case COMMAND_DISCOVER:
-                // not implemented
+                _discover(the_packet, transporter, id);
                 break;
 
             case COMMAND_REMOVE:
@@ -123,6 +156,22 @@ namespace rcp {
         }
     }
 
+    void ParameterServer::connected(ServerTransporter& transporter, void* id)
+    {
+        std::lock_guard<std::mutex> lock(m_clientsMutex);
+        m_clients[&transporter][id] = Client();
+    }
+
+    void ParameterServer::disconnected(ServerTransporter& transporter, void* id)
+    {
+        std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+        auto it = m_clients.find(&transporter);
+        if (it != m_clients.end()) {
+            it->second.erase(id);
+        }
+    }
+
     bool ParameterServer::addTransporter(ServerTransporter& transporter) {
 
         for(auto it = transporterList.begin(); it != transporterList.end(); it++ )    {
@@ -134,6 +183,8 @@ namespace rcp {
 
         // register as listener
         transporter.addReceivedCb(this, &ServerTransporterReceiver::received);
+        transporter.addConnectedCb(this, &ServerTransporterReceiver::connected);
+        transporter.addDisconnectedCb(this, &ServerTransporterReceiver::disconnected);
 
         transporterList.push_back(transporter);
 
@@ -146,7 +197,12 @@ namespace rcp {
             if (&transporter == &(*it).get()) {
                 // contained
                 it->get().removeReceivedCb(this);
+                it->get().removeConnectedCb(this);
+                it->get().removeDisconnectedCb(this);
                 transporterList.erase(it);
+
+                std::lock_guard<std::mutex> lock(m_clientsMutex);
+                m_clients.erase(&transporter);
                 return true;
             }
         }
@@ -175,76 +231,918 @@ namespace rcp {
 		// protect lists to be used from multiple threads
 		parameterManager->lock();
 
+        // changes of an open batch are sent on commitBatch,
+        // clients being initialized still get their slices
+        if (m_batchDepth == 0) {
+            _sendChanges(false);
+        }
+        _sendInitSlices();
+
+		// unlock mutex
+		parameterManager->unlock();
+		
+        return false;
+    }
+
+    void ParameterServer::beginBatch() {
+
+        // taking the lock makes sure a running update
+        // does not pick up changes of this batch
+        parameterManager->lock();
+        m_batchDepth++;
+        parameterManager->unlock();
+    }
+
+    void ParameterServer::commitBatch() {
+
+        parameterManager->lock();
+
+        if (m_batchDepth > 0) {
+            m_batchDepth--;
+
+            if (m_batchDepth == 0 &&
+                    transporterList.size() > 0) {
+                // send all changes of the batch in one go,
+                // rate limits must not split it
+                _sendChanges(true);
+            }
+        }
+
+        parameterManager->unlock();
+    }
+
+    void ParameterServer::_sendChanges(bool ignoreRate) {
+
+        // serialize all packets into one buffer
+        // and remember where each packet ends
+        BufferWriter writer;
+        std::vector<size_t> packet_ends;
+        std::vector<short> packet_ids;
+
         // send removes
         for (auto& p : parameterManager->removedParameter)
         {
+            m_updateRates.erase(p.second->getId());
+            m_initSegments.erase(p.second->getId());
+            m_initDirty = true;
+            m_initOrderDirty = true;
+            m_membershipDirty = true;
+
             WriteablePtr id_data = IdData::create(p.second->getId());
             Packet packet(COMMAND_REMOVE, id_data);
-            sendPacket(packet);
+            packet.write(writer, false);
+            packet_ends.push_back(writer.size());
+            // removes go to all clients
+            packet_ids.push_back(0);
         }
         parameterManager->removedParameter.clear();
 
         // send updates
+        parameterManager->collectDirtyParameter();
+
+        const auto now = std::chrono::steady_clock::now();
+
         for (auto& p : parameterManager->dirtyParameter) {
 
+            if (!m_updateRates.empty()) {
+
+                auto it = m_updateRates.find(p->getId());
+                if (it != m_updateRates.end()) {
+
+                    if (!ignoreRate &&
+                            now - it->second.lastSent < it->second.interval) {
+                        // too early, keep dirty for a later update
+                        parameterManager->dirtySet.set(p->getId());
+                        continue;
+                    }
+
+                    it->second.lastSent = now;
+                }
+            }
+
+            // cached init packet is outdated
+            m_initSegments.erase(p->getId());
+            m_initDirty = true;
+
             // TODO send COMMAND_UPDATEVALUE
             command_t cmd = COMMAND_UPDATE;
 
-            if (p.second->onlyValueChanged())
+            if (p->onlyValueChanged())
             {
                 cmd = COMMAND_UPDATEVALUE;
             }
+            else
+            {
+                // parameter may be new or moved
+                m_membershipDirty = true;
+                m_initOrderDirty = true;
+            }
 
-            Packet packet(cmd, p.second);
-            sendPacket(packet);
+            if (cmd == COMMAND_UPDATEVALUE) {
+                Packet::writeUpdateValue(writer, *p);
+            } else {
+                PacketView packet(cmd, *p);
+                packet.write(writer, false);
+            }
+            packet_ends.push_back(writer.size());
+            packet_ids.push_back(p->getId());
         }
         parameterManager->dirtyParameter.clear();
 
-		// unlock mutex
-		parameterManager->unlock();
-		
-        return false;
+        if (!packet_ends.empty()) {
+            _addToInits(packet_ids);
+            _sendUpdates(writer, packet_ends, packet_ids);
+        }
+    }
+
+    void ParameterServer::setMaxUpdateRate(short id, float rate) {
+
+        parameterManager->lock();
+
+        if (rate > 0) {
+            UpdateRate& update_rate = m_updateRates[id];
+            update_rate.interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.f / rate));
+            update_rate.rate = rate;
+        } else {
+            m_updateRates.erase(id);
+        }
+
+        parameterManager->unlock();
+    }
+
+    float ParameterServer::getMaxUpdateRate(short id) {
+
+        float rate = 0;
+
+        parameterManager->lock();
+
+        auto it = m_updateRates.find(id);
+        if (it != m_updateRates.end()) {
+            rate = it->second.rate;
+        }
+
+        parameterManager->unlock();
+
+        return rate;
+    }
+
+    void ParameterServer::_sendUpdates(BufferWriter& writer, const std::vector<size_t>& packetEnds, const std::vector<short>& packetIds) {
+
+        // single packets
+        std::vector<SharedBufferPtr> packets;
+        size_t start = 0;
+        for (size_t end : packetEnds) {
+
+            const char* data = writer.data() + start;
+
+            if (end - start > 2 &&
+                data[0] == COMMAND_UPDATEVALUE)
+            {
+                // updatevalue: command, id, ...
+                short id = static_cast<short>((static_cast<uint8_t>(data[1]) << 8) | static_cast<uint8_t>(data[2]));
+                packets.push_back(SharedBuffer::create(data, end - start, id));
+            }
+            else
+            {
+                packets.push_back(SharedBuffer::create(data, end - start));
+            }
+
+            start = end;
+        }
+
+        // all packets in one message, created when needed
+        SharedBufferPtr multi_packet;
+
+        struct Subscriber {
+            void* id;
+            bool multiPacket;
+            Client client;
+        };
+
+        for (auto& transporterW : transporterList) {
+
+            ServerTransporter& transporter = transporterW.get();
+
+            std::vector<void*> multi_clients;
+            std::vector<void*> single_clients;
+            std::vector<Subscriber> subscribers;
+
+            {
+                std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+                auto it = m_clients.find(&transporter);
+                if (it != m_clients.end()) {
+                    for (const auto& client : it->second) {
+                        if (client.second.isFiltered()) {
+                            subscribers.push_back({ client.first,
+                                                    m_multiPacketUpdates && client.second.multiPacket,
+                                                    client.second });
+                        } else if (m_multiPacketUpdates && client.second.multiPacket) {
+                            multi_clients.push_back(client.first);
+                        } else {
+                            single_clients.push_back(client.first);
+                        }
+                    }
+                }
+            }
+
+            if (multi_clients.empty() &&
+                    subscribers.empty()) {
+                // send every packet to all clients
+                for (const auto& packet : packets) {
+                    transporter.sendToAll(packet, nullptr);
+                }
+                continue;
+            }
+
+            if (!multi_clients.empty()) {
+
+                if (!multi_packet) {
+                    multi_packet = SharedBuffer::create(writer.data(), writer.size());
+                }
+
+                transporter.sendToMany(multi_packet, multi_clients);
+            }
+
+            // every packet is framed once for all single-packet clients
+            if (!single_clients.empty()) {
+                for (const auto& packet : packets) {
+                    transporter.sendToMany(packet, single_clients);
+                }
+            }
+
+            if (subscribers.empty()) {
+                continue;
+            }
+
+            // membership of all subscribed groups
+            std::vector<short> groups;
+            for (const auto& subscriber : subscribers) {
+                groups.insert(groups.end(), subscriber.client.subscriptions.begin(), subscriber.client.subscriptions.end());
+            }
+            std::sort(groups.begin(), groups.end());
+            groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+
+            _updateMembership(groups);
+
+            // clients with the same filter share the filtered packets
+            std::sort(subscribers.begin(), subscribers.end(), [](const Subscriber& a, const Subscriber& b) {
+                return a.client.filterLess(b.client);
+            });
+
+            std::vector<size_t> selected;
+            std::vector<void*> selected_multi_clients;
+            std::vector<void*> selected_single_clients;
+
+            for (size_t i = 0; i < subscribers.size(); ) {
+
+                // clients with the same filter
+                size_t end = i + 1;
+                while (end < subscribers.size() &&
+                       !subscribers[i].client.filterLess(subscribers[end].client)) {
+                    end++;
+                }
+
+                selected.clear();
+                for (size_t j = 0; j < packets.size(); j++) {
+                    if (packetIds[j] == 0 ||
+                            _isVisible(packetIds[j], subscribers[i].client)) {
+                        selected.push_back(j);
+                    }
+                }
+
+                if (selected.empty()) {
+                    i = end;
+                    continue;
+                }
+
+                selected_multi_clients.clear();
+                selected_single_clients.clear();
+                for (; i < end; i++) {
+                    if (subscribers[i].multiPacket) {
+                        selected_multi_clients.push_back(subscribers[i].id);
+                    } else {
+                        selected_single_clients.push_back(subscribers[i].id);
+                    }
+                }
+
+                if (!selected_multi_clients.empty()) {
+                    std::string data;
+                    for (size_t j : selected) {
+                        data.append(packets[j]->data(), packets[j]->size());
+                    }
+                    transporter.sendToMany(SharedBuffer::create(std::move(data)), selected_multi_clients);
+                }
+
+                if (!selected_single_clients.empty()) {
+                    for (size_t j : selected) {
+                        transporter.sendToMany(packets[j], selected_single_clients);
+                    }
+                }
+            }
+        }
     }
 
-    void ParameterServer::sendPacket(Packet& packet, void *id) {
+    void ParameterServer::_forward(const SharedBufferPtr& buffer, void* excludeId, short parameterId) {
 
-        // serialize
-        StringStreamWriter writer;
-        packet.write(writer, false);
+        bool filtered = false;
+        {
+            std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+            for (const auto& clients : m_clients) {
+                for (const auto& client : clients.second) {
+                    if (client.second.isFiltered()) {
+                        filtered = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!filtered) {
+            for (auto& transporter : transporterList) {
+                transporter.get().sendToAll(buffer, excludeId);
+            }
+            return;
+        }
+
+        parameterManager->lock();
 
         for (auto& transporterW : transporterList) {
-            transporterW.get().sendToAll(writer.getBuffer(), id);
+
+            ServerTransporter& transporter = transporterW.get();
+
+            std::vector<void*> receivers;
+            {
+                std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+                auto it = m_clients.find(&transporter);
+                if (it == m_clients.end()) {
+                    continue;
+                }
+
+                for (const auto& client : it->second) {
+
+                    if (client.first == excludeId) {
+                        continue;
+                    }
+
+                    if (client.second.isFiltered()) {
+
+                        _updateMembership(client.second.subscriptions);
+
+                        if (!_isVisible(parameterId, client.second)) {
+                            continue;
+                        }
+                    }
+
+                    receivers.push_back(client.first);
+                }
+            }
+
+            transporter.sendToMany(buffer, receivers);
+        }
+
+        parameterManager->unlock();
+    }
+
+    void ParameterServer::_updateMembership(const std::vector<short>& groups) {
+
+        // call with manager lock held
+        if (!m_membershipDirty &&
+                std::includes(m_memberGroups.begin(), m_memberGroups.end(), groups.begin(), groups.end())) {
+            return;
         }
+
+        // keep groups of other clients
+        std::vector<short> all_groups;
+        std::set_union(m_memberGroups.begin(), m_memberGroups.end(), groups.begin(), groups.end(), std::back_inserter(all_groups));
+        _buildMembership(all_groups);
     }
 
+    void ParameterServer::_buildMembership(const std::vector<short>& groups) {
+
+        // call with manager lock held
+        m_memberOf.clear();
+        m_memberGroups = groups;
+        m_membershipDirty = false;
+
+        for (short group_id : groups) {
 
-    void ParameterServer::_sendParameterFull(ParameterPtr& parameter, ServerTransporter& transporter, void *id) {
+            IParameter* parameter = group_id == 0 ? root.get() : parameterManager->findParameter(group_id);
 
-        Packet packet(COMMAND_UPDATE);
-        packet.setData(parameter);
+            if (parameter &&
+                    parameter->getDatatype() == DATATYPE_GROUP) {
+                m_memberOf[group_id].push_back(group_id);
+                _addMembers(*static_cast<GroupParameter*>(parameter), group_id);
+            }
+        }
+    }
 
-        // serialize
-        StringStreamWriter aWriter;
-        packet.write(aWriter, true);
+    void ParameterServer::_addMembers(GroupParameter& group, short groupId) {
 
-        transporter.sendToOne(aWriter.getBuffer(), id);
+        for (auto& child : group.children()) {
 
-        if (parameter->getTypeDefinition().getDatatype() == DATATYPE_GROUP) {
+            ParameterPtr& parameter = child.second;
+            m_memberOf[parameter->getId()].push_back(groupId);
 
-            std::shared_ptr<GroupParameter> group_param = std::dynamic_pointer_cast<GroupParameter>(parameter);
-            if (group_param) {
-                for (auto& child : group_param->children()) {
-                    _sendParameterFull(child.second, transporter, id);
+            if (parameter->getDatatype() == DATATYPE_GROUP) {
+                _addMembers(*std::static_pointer_cast<GroupParameter>(parameter), groupId);
+            }
+        }
+    }
+
+    void ParameterServer::_addToInits(const std::vector<short>& ids) {
+
+        // call with manager lock held
+        // parameter created while a client is initializing
+        // are sent at the end of its init
+        std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+        for (auto& transporter : m_clients) {
+            for (auto& client : transporter.second) {
+
+                if (!client.second.init) {
+                    continue;
+                }
+
+                InitCursor& cursor = *client.second.init;
+
+                for (short id : ids) {
+                    if (id == 0 ||
+                            cursor.order->index.find(id) != cursor.order->index.end()) {
+                        continue;
+                    }
+
+                    if (std::find(cursor.added.begin(), cursor.added.end(), id) == cursor.added.end()) {
+                        cursor.added.push_back(id);
+                    }
                 }
             }
         }
     }
 
+    bool ParameterServer::_isVisible(short id, const Client& client) const {
+
+        // call with manager lock held
+        if (client.init) {
+
+            const InitCursor& cursor = *client.init;
+
+            auto it = cursor.order->index.find(id);
+            if (it == cursor.order->index.end() ||
+                    it->second >= cursor.position) {
+                // not sent yet: the cursor sends the current state,
+                // parameter created while initializing are sent at the end
+                return false;
+            }
+        }
+
+        if (!client.subscriptions.empty() &&
+                !_isMember(id, client.subscriptions)) {
+            return false;
+        }
+
+        if (client.discovering) {
+            // only parameter of discovered groups
+            IParameter* parameter = parameterManager->findParameter(id);
+            if (!parameter) {
+                return false;
+            }
+
+            GroupParameterPtr parent = parameter->getParent().lock();
+            short parent_id = parent ? parent->getId() : 0;
+
+            return std::binary_search(client.discovered.begin(), client.discovered.end(), parent_id);
+        }
+
+        return true;
+    }
+
+    bool ParameterServer::_isMember(short id, const std::vector<short>& groups) const {
+
+        auto it = m_memberOf.find(id);
+        if (it == m_memberOf.end()) {
+            return false;
+        }
+
+        for (short group_id : it->second) {
+            if (std::binary_search(groups.begin(), groups.end(), group_id)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ParameterServer::_buildInit() {
+
+        // call with manager lock held
+
+        // pending changes and removes are not in the cache yet.
+        // changes of an open batch are not visible before commit
+        if (!m_initDirty &&
+            (m_batchDepth > 0 || parameterManager->dirtySet.empty()) &&
+            parameterManager->removedParameter.empty())
+        {
+            return;
+        }
+
+        BufferWriter writer;
+        m_initPackets.clear();
+        m_initSegmentsNext.clear();
+
+        _buildInitSegments(root, writer);
+
+        // drop segments of parameter not in the tree anymore
+        m_initSegments.swap(m_initSegmentsNext);
+        m_initSegmentsNext.clear();
+
+        // joined on demand for multi-packet clients
+        m_initBuffer.reset();
+        m_initDirty = false;
+    }
+
+    void ParameterServer::_buildInitSegments(GroupParameterPtr& group, BufferWriter& writer) {
+
+        for (auto& child : group->children()) {
+
+            ParameterPtr& parameter = child.second;
+            short id = parameter->getId();
+
+            SharedBufferPtr segment;
+
+            auto it = m_initSegments.find(id);
+            if (it != m_initSegments.end() &&
+                (m_batchDepth > 0 || !parameterManager->dirtySet.test(id)))
+            {
+                segment = it->second;
+            }
+            else
+            {
+                PacketView packet(COMMAND_UPDATE, *parameter);
+
+                // serialize
+                writer.clear();
+                packet.write(writer, true);
+
+                segment = SharedBuffer::create(writer.data(), writer.size());
+            }
+
+            m_initSegmentsNext[id] = segment;
+            m_initPackets.push_back(segment);
+
+            if (parameter->getDatatype() == DATATYPE_GROUP) {
+                GroupParameterPtr group_param = std::static_pointer_cast<GroupParameter>(parameter);
+                _buildInitSegments(group_param, writer);
+            }
+        }
+    }
+
+    void ParameterServer::_buildInitOrder() {
+
+        // call with manager lock held
+        // ids only, sliced inits serialize as they go.
+        // parameter created later are sent at the end of the init
+        if (m_initOrder &&
+            !m_initOrderDirty &&
+            parameterManager->removedParameter.empty())
+        {
+            return;
+        }
+
+        // cursors keep the order they started with
+        m_initOrder = std::make_shared<InitOrder>();
+        m_initOrder->ids.reserve(parameterManager->params.size());
+        _buildInitOrder(*root);
+
+        m_initOrder->index.reserve(m_initOrder->ids.size());
+        for (size_t i = 0; i < m_initOrder->ids.size(); i++) {
+            m_initOrder->index[m_initOrder->ids[i]] = i;
+        }
+
+        m_initOrderDirty = false;
+    }
+
+    void ParameterServer::_buildInitOrder(GroupParameter& group) {
+
+        for (auto& child : group.children()) {
+
+            ParameterPtr& parameter = child.second;
+            m_initOrder->ids.push_back(parameter->getId());
+
+            if (parameter->getDatatype() == DATATYPE_GROUP) {
+                _buildInitOrder(*std::static_pointer_cast<GroupParameter>(parameter));
+            }
+        }
+    }
+
+    void ParameterServer::_clearInit() {
+
+        // call with manager lock held
+        m_initSegments.clear();
+        m_initPackets.clear();
+        m_initBuffer.reset();
+        m_initOrder.reset();
+        m_initDirty = true;
+        m_initOrderDirty = true;
+    }
+
+    bool ParameterServer::_isMultiPacketClient(ServerTransporter& transporter, void *id) {
+
+        if (!m_multiPacketUpdates) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+        auto it = m_clients.find(&transporter);
+        if (it != m_clients.end()) {
+            auto client = it->second.find(id);
+            return client != it->second.end() && client->second.multiPacket;
+        }
+
+        return false;
+    }
 
     void ParameterServer::_init(ServerTransporter& transporter, void *id) {
 
-        for (auto& child : root->children()) {
-            _sendParameterFull(child.second, transporter, id);
+        bool multi_packet = _isMultiPacketClient(transporter, id);
+
+        {
+            // client gets the whole tree
+            std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+            auto it = m_clients.find(&transporter);
+            if (it != m_clients.end()) {
+                auto client = it->second.find(id);
+                if (client != it->second.end()) {
+                    client->second.discovering = false;
+                    client->second.discovered.clear();
+                    client->second.init.reset();
+                }
+            }
+        }
+
+        SharedBufferPtr buffer;
+        std::vector<SharedBufferPtr> packets;
+
+        parameterManager->lock();
+
+        if (m_initSliceSize > 0) {
+
+            // no encoding here: each slice serializes its parameter.
+            // send the first slice now, the rest with update
+            _buildInitOrder();
+
+            std::shared_ptr<InitCursor> cursor = std::make_shared<InitCursor>();
+            cursor->order = m_initOrder;
+            cursor->multiPacket = multi_packet;
+
+            if (!_sendInitSlice(transporter, id, *cursor)) {
+
+                std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+                auto it = m_clients.find(&transporter);
+                if (it != m_clients.end()) {
+                    auto client = it->second.find(id);
+                    if (client != it->second.end()) {
+                        client->second.init = cursor;
+                    }
+                }
+            }
+
+            parameterManager->unlock();
+            return;
+        }
+
+        _buildInit();
+
+        if (multi_packet) {
+
+            // all packets in one buffer
+            if (!m_initBuffer) {
+
+                size_t size = 0;
+                for (const auto& packet : m_initPackets) {
+                    size += packet->size();
+                }
+
+                std::string data;
+                data.reserve(size);
+                for (const auto& packet : m_initPackets) {
+                    data.append(packet->data(), packet->size());
+                }
+
+                m_initBuffer = SharedBuffer::create(std::move(data));
+            }
+
+            buffer = m_initBuffer;
+        } else {
+            packets = m_initPackets;
+        }
+
+        parameterManager->unlock();
+
+        // send outside the lock
+        if (multi_packet) {
+            if (buffer->size() > 0) {
+                transporter.sendToOne(buffer, id);
+            }
+            return;
+        }
+
+        for (const auto& packet : packets) {
+            transporter.sendToOne(packet, id);
+        }
+    }
+
+    void ParameterServer::_sendInitSlices() {
+
+        // call with manager lock held
+        struct Initializing {
+            ServerTransporter* transporter;
+            void* id;
+            std::shared_ptr<InitCursor> cursor;
+        };
+
+        std::vector<Initializing> clients;
+        {
+            std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+            for (auto& transporter_clients : m_clients) {
+                for (auto& client : transporter_clients.second) {
+                    if (client.second.init) {
+                        clients.push_back({ transporter_clients.first, client.first, client.second.init });
+                    }
+                }
+            }
+        }
+
+        for (auto& client : clients) {
+
+            if (!_sendInitSlice(*client.transporter, client.id, *client.cursor)) {
+                continue;
+            }
+
+            // done, client gets all updates from now on
+            std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+            auto it = m_clients.find(client.transporter);
+            if (it != m_clients.end()) {
+                auto c = it->second.find(client.id);
+                if (c != it->second.end() &&
+                        c->second.init == client.cursor) {
+                    c->second.init.reset();
+                }
+            }
+        }
+    }
+
+    bool ParameterServer::_sendInitSlice(ServerTransporter& transporter, void *id, InitCursor& cursor) {
+
+        // call with manager lock held
+        // packets of one slice, serialized with the current state
+        std::vector<SharedBufferPtr> packets;
+        BufferWriter writer;
+        size_t size = 0;
+
+        const std::vector<short>& ids = cursor.order->ids;
+
+        while (cursor.position < ids.size() &&
+               size < m_initSliceSize) {
+
+            IParameter* parameter = parameterManager->findParameter(ids[cursor.position++]);
+            if (parameter) {
+                packets.push_back(_initSegment(*parameter, writer));
+                size += packets.back()->size();
+            }
+        }
+
+        bool done = cursor.position == ids.size();
+
+        if (done) {
+            // parameter created while initializing
+            for (short added_id : cursor.added) {
+                IParameter* parameter = parameterManager->findParameter(added_id);
+                if (parameter) {
+                    packets.push_back(_initSegment(*parameter, writer));
+                }
+            }
+            cursor.added.clear();
+        }
+
+        if (cursor.multiPacket) {
+
+            std::string data;
+            data.reserve(size);
+            for (const auto& packet : packets) {
+                data.append(packet->data(), packet->size());
+            }
+
+            if (!data.empty()) {
+                transporter.sendToOne(SharedBuffer::create(std::move(data)), id);
+            }
+        } else {
+            for (const auto& packet : packets) {
+                transporter.sendToOne(packet, id);
+            }
+        }
+
+        return done;
+    }
+
+    SharedBufferPtr ParameterServer::_initSegment(IParameter& parameter, BufferWriter& writer) {
+
+        // call with manager lock held
+        // cached packet if up to date
+        short id = parameter.getId();
+
+        auto segment = m_initSegments.find(id);
+        if (segment != m_initSegments.end() &&
+            (m_batchDepth > 0 || !parameterManager->dirtySet.test(id)))
+        {
+            return segment->second;
+        }
+
+        PacketView packet(COMMAND_UPDATE, parameter);
+
+        writer.clear();
+        packet.write(writer, true);
+
+        // reused by the next client until the parameter changes
+        SharedBufferPtr created = SharedBuffer::create(writer.data(), writer.size());
+        m_initSegments[id] = created;
+
+        return created;
+    }
+
+    void ParameterServer::_discover(Packet& packet, ServerTransporter& transporter, void *id) {
+
+        // id of the group to expand, root if none
+        short group_id = 0;
+        if (packet.hasData()) {
+            IdDataPtr id_data = std::dynamic_pointer_cast<IdData>(packet.getData());
+            if (id_data) {
+                group_id = id_data->getId();
+            }
+        }
+
+        bool multi_packet = _isMultiPacketClient(transporter, id);
+
+        parameterManager->lock();
+
+        IParameter* parameter = group_id == 0 ? root.get() : parameterManager->findParameter(group_id);
+
+        if (!parameter ||
+                parameter->getDatatype() != DATATYPE_GROUP) {
+            parameterManager->unlock();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+            auto it = m_clients.find(&transporter);
+            if (it != m_clients.end()) {
+                auto client = it->second.find(id);
+                if (client != it->second.end()) {
+
+                    std::vector<short>& discovered = client->second.discovered;
+                    auto pos = std::lower_bound(discovered.begin(), discovered.end(), group_id);
+                    if (pos == discovered.end() || *pos != group_id) {
+                        discovered.insert(pos, group_id);
+                    }
+                    client->second.discovering = true;
+                }
+            }
+        }
+
+        // direct children only, from the init cache if up to date
+        std::vector<SharedBufferPtr> packets;
+        BufferWriter writer;
+
+        for (auto& child : static_cast<GroupParameter*>(parameter)->children()) {
+            packets.push_back(_initSegment(*child.second, writer));
+        }
+
+        parameterManager->unlock();
+
+        // send outside the lock
+        if (multi_packet) {
+
+            std::string data;
+            for (const auto& child_packet : packets) {
+                data.append(child_packet->data(), child_packet->size());
+            }
+
+            if (!data.empty()) {
+                transporter.sendToOne(SharedBuffer::create(std::move(data)), id);
+            }
+        } else {
+            for (const auto& child_packet : packets) {
+                transporter.sendToOne(child_packet, id);
+            }
         }
     }
 
@@ -256,12 +1154,15 @@ namespace rcp {
         }
 
         // assume this is a parameter!!
-        ParameterPtr param = std::dynamic_pointer_cast<IParameter>(packet.getData());
-        if (param)
+        const WriteablePtr& data = packet.getData();
+        if (IParameter* p = data->asParameter())
         {
-            ParameterPtr chached_param = parameterManager->getParameter(param->getId());
+            // shares ownership with the packet data
+            ParameterPtr param(data, p);
+
+            IParameter* chached_param = parameterManager->findParameter(param->getId());
 
-            if (ParameterManager::isValid(chached_param))
+            if (chached_param)
             {
                 // got it... update it
                 chached_param->update(param);
@@ -296,20 +1197,40 @@ namespace rcp {
             if (info_data) {
                 std::cout << "version: " << info_data->getVersion() << std::endl;
                 std::cout << "applicationid: " << info_data->getApplicationId() << std::endl;
+
+                // only remember known clients
+                std::lock_guard<std::mutex> lock(m_clientsMutex);
+
+                auto it = m_clients.find(&transporter);
+                if (it != m_clients.end()) {
+                    auto client = it->second.find(id);
+                    if (client != it->second.end()) {
+                        client->second.multiPacket = info_data->getMultiPacket();
+
+                        std::vector<short>& subscriptions = client->second.subscriptions;
+                        subscriptions.assign(info_data->getSubscriptions().begin(), info_data->getSubscriptions().end());
+                        std::sort(subscriptions.begin(), subscriptions.end());
+                        subscriptions.erase(std::unique(subscriptions.begin(), subscriptions.end()), subscriptions.end());
+                    }
+                }
             }
         } else {
             // no data, respond with version
-            WriteablePtr version = InfoData::create(RCP_SPECIFICATION_VERSION, m_applicationId);
+            InfoDataPtr info_data = InfoData::create(RCP_SPECIFICATION_VERSION, m_applicationId);
+            // clients may send subscriptions
+            info_data->setAcceptsSubscriptions(true);
+
+            WriteablePtr version = info_data;
             Packet resp_packet(COMMAND_INFO, version);
-            StringStreamWriter writer;
+            BufferWriter writer;
             resp_packet.write(writer, false);
-            transporter.sendToOne(writer.getBuffer(), id);
+            transporter.sendToOne(writer.getSharedBuffer(), id);
 
             // ask for version
-            StringStreamWriter writer1;
+            BufferWriter writer1;
             Packet req_info_packet(COMMAND_INFO);
             req_info_packet.write(writer1, false);
-            transporter.sendToOne(writer1.getBuffer(), id);
+            transporter.sendToOne(writer1.getSharedBuffer(), id);
 
         }
 
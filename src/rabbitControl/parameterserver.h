@@ -36,6 +36,10 @@
 #define RCPSERVER_H
 
 #include <set>
+#include <mutex>
+#include <unordered_map>
+#include <chrono>
+#include <tuple>
 
 #include "servertransporter.h"
 #include "parametermanager.h"
@@ -44,6 +48,7 @@
 namespace rcp {
 
     class Packet;
+    class BufferWriter;
 class ParameterServer : public ServerTransporterReceiver
 {
 public:
@@ -61,9 +66,65 @@ public:
 
     virtual bool update();
 
+    // hold back changes until the matching commitBatch.
+    // all changes of a batch are sent together, clients
+    // never see a partial state. batches can be nested
+    void beginBatch();
+    void commitBatch();
+
+    // begins a batch and commits it when going out of scope
+    class Batch
+    {
+    public:
+        Batch(ParameterServer& server) : m_server(server) {
+            m_server.beginBatch();
+        }
+        ~Batch() {
+            m_server.commitBatch();
+        }
+
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+    private:
+        ParameterServer& m_server;
+    };
+
 public:
     // ServerTransporterReceiver
-    void received(std::istream& data, ServerTransporter& transporter, void* id);
+    void received(const char* data, size_t size, ServerTransporter& transporter, void* id);
+    using ServerTransporterReceiver::received;
+    void connected(ServerTransporter& transporter, void* id);
+    void disconnected(ServerTransporter& transporter, void* id);
+
+public:
+    // send all packets of one update in a single message
+    // to clients which announced multipacket support.
+    // other clients get one message per packet
+    void setMultiPacketUpdates(bool enable) {
+        m_multiPacketUpdates = enable;
+    }
+    bool getMultiPacketUpdates() const {
+        return m_multiPacketUpdates;
+    }
+
+    // send init to a client in slices of about this many bytes,
+    // one slice per update. live updates continue in between.
+    // 0: send the whole tree at once
+    void setInitSliceSize(size_t bytes) {
+        m_initSliceSize = bytes;
+    }
+    size_t getInitSliceSize() const {
+        return m_initSliceSize;
+    }
+
+    // send changes of a parameter at most rate times per second.
+    // changes in between are merged into the next update, 0: no limit
+    void setMaxUpdateRate(IParameter& parameter, float rate) {
+        setMaxUpdateRate(parameter.getId(), rate);
+    }
+    void setMaxUpdateRate(short id, float rate);
+    float getMaxUpdateRate(short id);
 
 public:
     GroupParameterPtr& getRoot() { return root; }
@@ -72,6 +133,22 @@ public:
         return parameterManager->getParameter(id);
     }
 
+    // non-owning lookup, returns nullptr if id is unknown
+    IParameter* findParameter(short id) {
+        return parameterManager->findParameter(id);
+    }
+
+    // typed lookup, returns nullptr if id is unknown or of another datatype
+    template<typename T>
+    T* get(short id) {
+        return parameterManager->get<T>(id);
+    }
+
+    template<typename T>
+    std::shared_ptr<T> getShared(short id) {
+        return parameterManager->getShared<T>(id);
+    }
+
     //
     void removeParameter(IParameter& parameter) {
         parameterManager->removeParameter(parameter);
@@ -155,6 +232,31 @@ public:
         return parameterManager->createBangParameter(label, group);
     }
 
+    // create a parameter of any value type, e.g. createParameter<UInt16Parameter>
+    template<typename T>
+    std::shared_ptr<T> createParameter(const std::string& label) {
+        return parameterManager->createParameter<T>(label, root);
+    }
+    template<typename T>
+    std::shared_ptr<T> createParameter(const std::string& label, GroupParameterPtr& group) {
+        return parameterManager->createParameter<T>(label, group);
+    }
+
+    // create parameter of one value type for all labels in one go
+    template<typename T>
+    std::vector<std::shared_ptr<T> > createParameters(const std::vector<std::string>& labels) {
+        return parameterManager->createParameters<T>(labels, root);
+    }
+    template<typename T>
+    std::vector<std::shared_ptr<T> > createParameters(const std::vector<std::string>& labels, GroupParameterPtr& group) {
+        return parameterManager->createParameters<T>(labels, group);
+    }
+
+    // make room for count more parameter in group before creating them
+    void reserveParameters(size_t count, GroupParameterPtr& group) {
+        parameterManager->reserve(count, group);
+    }
+
     GroupParameterPtr createGroupParameter(const std::string& label) {
         return parameterManager->createGroupParameter(label, root);
     }
@@ -175,6 +277,15 @@ public:
         std::flush(std::cout);
     }
 
+    // number of released ids to keep before reusing an id
+    // avoids mixing up recycled ids with stale client state
+    void setIdQuarantine(size_t count) {
+        parameterManager->setIdQuarantine(count);
+    }
+    size_t getIdQuarantine() const {
+        return parameterManager->getIdQuarantine();
+    }
+
     void setApplicationId(const std::string& appid) {
         m_applicationId = appid;
     }
@@ -188,13 +299,106 @@ protected:
 	std::vector<std::reference_wrapper<ServerTransporter> > transporterList;
 	
 private:
+    struct Client;
+
     void _init(ServerTransporter& transporter, void *id);
+    void _discover(Packet& packet, ServerTransporter& transporter, void *id);
+    struct InitCursor;
+    void _sendInitSlices();
+    bool _sendInitSlice(ServerTransporter& transporter, void *id, InitCursor& cursor);
+    SharedBufferPtr _initSegment(IParameter& parameter, BufferWriter& writer);
     bool _update(Packet& Packet, ServerTransporter& transporter, void *id);
     void _version(Packet& packet, ServerTransporter& transporter, void *id);
-    void _sendParameterFull(ParameterPtr& parameter, ServerTransporter& transporter, void *id);
+    void _buildInit();
+    void _buildInitSegments(GroupParameterPtr& group, BufferWriter& writer);
+    void _buildInitOrder();
+    void _buildInitOrder(GroupParameter& group);
+    void _clearInit();
+    bool _isMultiPacketClient(ServerTransporter& transporter, void *id);
     void sendPacket(Packet& packet, void *id=nullptr);
+    void _sendUpdates(BufferWriter& writer, const std::vector<size_t>& packetEnds, const std::vector<short>& packetIds);
+    void _forward(const SharedBufferPtr& buffer, void* excludeId, short parameterId);
+    void _updateMembership(const std::vector<short>& groups);
+    void _buildMembership(const std::vector<short>& groups);
+    void _addMembers(GroupParameter& group, short groupId);
+    bool _isMember(short id, const std::vector<short>& groups) const;
+    bool _isVisible(short id, const Client& client) const;
+    void _addToInits(const std::vector<short>& ids);
+    void _sendChanges(bool ignoreRate);
 
     std::string m_applicationId;
+
+    // connected clients per transporter
+    struct Client {
+        // client can parse multiple packets in one message
+        bool multiPacket{false};
+        // sorted ids of subscribed groups, empty: all updates
+        std::vector<short> subscriptions;
+        // init in progress, client only gets updates of parameter already sent
+        std::shared_ptr<InitCursor> init;
+        // client discovers the tree group by group and only
+        // gets updates of children of discovered groups (sorted)
+        bool discovering{false};
+        std::vector<short> discovered;
+
+        bool isFiltered() const {
+            return init || discovering || !subscriptions.empty();
+        }
+        bool filterLess(const Client& other) const {
+            return std::tie(init, subscriptions, discovering, discovered) <
+                    std::tie(other.init, other.subscriptions, other.discovering, other.discovered);
+        }
+    };
+    std::map<ServerTransporter*, std::map<void*, Client> > m_clients;
+    std::mutex m_clientsMutex;
+    bool m_multiPacketUpdates{false};
+
+    // subscribed groups each parameter belongs to.
+    // only built for subscribed groups and rebuilt when the
+    // tree changes. protected by the manager lock
+    std::unordered_map<short, std::vector<short> > m_memberOf;
+    std::vector<short> m_memberGroups;
+    bool m_membershipDirty{true};
+
+    // rate limited parameter, protected by the manager lock
+    struct UpdateRate {
+        std::chrono::steady_clock::duration interval;
+        std::chrono::steady_clock::time_point lastSent;
+        float rate;
+    };
+    std::unordered_map<short, UpdateRate> m_updateRates;
+
+    // open batches, protected by the manager lock
+    int m_batchDepth{0};
+
+    // ids of the tree in order for sliced inits,
+    // shared with the cursors of clients being initialized
+    struct InitOrder {
+        std::vector<short> ids;
+        std::unordered_map<short, size_t> index;
+    };
+    std::shared_ptr<InitOrder> m_initOrder;
+    bool m_initOrderDirty{true};
+
+    // position of a sliced init
+    struct InitCursor {
+        std::shared_ptr<InitOrder> order;
+        size_t position{0};
+        // parameter created after the init started
+        std::vector<short> added;
+        bool multiPacket{false};
+    };
+    size_t m_initSliceSize{0};
+
+    // cached init: one serialized packet per parameter,
+    // the packets of an unsliced init in tree order
+    // and, for multi-packet clients, all of them in one buffer.
+    // protected by the manager lock
+    std::unordered_map<short, SharedBufferPtr> m_initSegments;
+    std::unordered_map<short, SharedBufferPtr> m_initSegmentsNext;
+    std::vector<SharedBufferPtr> m_initPackets;
+    SharedBufferPtr m_initBuffer;
+    bool m_initDirty{true};
 //    Events:
     std::map<ParsingErrorListener*, void(ParsingErrorListener::*)()> parsing_error_cb;
 //    onError(Exception ex);
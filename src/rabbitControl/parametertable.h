@@ -0,0 +1,237 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_PARAMETERTABLE_H
+#define RCP_PARAMETERTABLE_H
+
+#include <algorithm>
+#include <vector>
+#include <array>
+#include <memory>
+#include <inttypes.h>
+
+#include "iparameter.h"
+
+namespace rcp {
+
+    /*
+     * ParameterTable maps parameter ids to parameters.
+     * parameters are stored densely in insertion order,
+     * a paged index gives O(1) access by id.
+     *
+     * erasing leaves an empty slot, so erasing while iterating is safe.
+     * empty slots are compacted when inserting, don't insert while iterating.
+    */
+    class ParameterTable
+    {
+    public:
+        struct Entry {
+            short first;
+            ParameterPtr second;
+        };
+
+        class iterator {
+        public:
+            iterator(std::vector<Entry>& entries, size_t pos) :
+                m_entries(entries)
+              , m_pos(pos)
+              , m_end(entries.size())
+            {
+                skip();
+            }
+
+            Entry& operator*() const { return m_entries[m_pos]; }
+            Entry* operator->() const { return &m_entries[m_pos]; }
+
+            iterator& operator++() {
+                m_pos++;
+                skip();
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const { return m_pos == other.m_pos; }
+            bool operator!=(const iterator& other) const { return m_pos != other.m_pos; }
+
+        private:
+            // skip erased slots
+            void skip() {
+                while (m_pos < m_end && !m_entries[m_pos].second) {
+                    m_pos++;
+                }
+            }
+
+            std::vector<Entry>& m_entries;
+            size_t m_pos;
+            size_t m_end;
+        };
+
+        iterator begin() { return iterator(m_entries, 0); }
+        iterator end() { return iterator(m_entries, m_entries.size()); }
+
+        bool contains(short id) const {
+            return slot(id) != 0;
+        }
+
+        // returns nullptr if id is not contained
+        ParameterPtr get(short id) const {
+            uint32_t s = slot(id);
+            return s != 0 ? m_entries[s - 1].second : nullptr;
+        }
+
+        // non-owning, returns nullptr if id is not contained
+        IParameter* find(short id) const {
+            uint32_t s = slot(id);
+            return s != 0 ? m_entries[s - 1].second.get() : nullptr;
+        }
+
+        // insert or replace, the position of an existing id is kept
+        void set(short id, const ParameterPtr& parameter) {
+
+            if (!parameter) {
+                erase(id);
+                return;
+            }
+
+            uint32_t s = slot(id);
+            if (s != 0) {
+                m_entries[s - 1].second = parameter;
+                return;
+            }
+
+            if (m_erased > 32 && m_erased > m_size) {
+                compact();
+            }
+
+            m_entries.push_back(Entry{id, parameter});
+            setSlot(id, static_cast<uint32_t>(m_entries.size()));
+            m_size++;
+        }
+
+        bool erase(short id) {
+
+            uint32_t s = slot(id);
+            if (s == 0) {
+                return false;
+            }
+
+            // keep the slot to not disturb iteration
+            m_entries[s - 1].second.reset();
+            setSlot(id, 0);
+            m_size--;
+            m_erased++;
+
+            return true;
+        }
+
+        void clear() {
+            for (const auto& entry : m_entries) {
+                if (entry.second) {
+                    setSlot(entry.first, 0);
+                }
+            }
+            m_entries.clear();
+            m_size = 0;
+            m_erased = 0;
+        }
+
+        // make room for count more parameters
+        // keeps growing geometrically when called for many small batches
+        void reserve(size_t count) {
+            size_t needed = m_entries.size() + count;
+            if (needed > m_entries.capacity()) {
+                m_entries.reserve(std::max(needed, m_entries.capacity() * 2));
+            }
+        }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+    private:
+        static const size_t PAGE_SIZE = 256;
+        typedef std::array<uint32_t, PAGE_SIZE> Page;
+
+        // index into m_entries + 1, 0 if not contained
+        uint32_t slot(short id) const {
+            uint16_t i = static_cast<uint16_t>(id);
+            size_t page = i / PAGE_SIZE;
+
+            if (page >= m_pages.size() || !m_pages[page]) {
+                return 0;
+            }
+            return (*m_pages[page])[i % PAGE_SIZE];
+        }
+
+        void setSlot(short id, uint32_t s) {
+            uint16_t i = static_cast<uint16_t>(id);
+            size_t page = i / PAGE_SIZE;
+
+            if (page >= m_pages.size()) {
+                if (s == 0) return;
+                m_pages.resize(page + 1);
+            }
+
+            if (!m_pages[page]) {
+                if (s == 0) return;
+                m_pages[page].reset(new Page());
+                m_pages[page]->fill(0);
+            }
+
+            (*m_pages[page])[i % PAGE_SIZE] = s;
+        }
+
+        void compact() {
+
+            size_t n = 0;
+            for (size_t i=0; i<m_entries.size(); i++) {
+                if (m_entries[i].second) {
+                    if (n != i) {
+                        m_entries[n] = std::move(m_entries[i]);
+                    }
+                    n++;
+                    setSlot(m_entries[n-1].first, static_cast<uint32_t>(n));
+                }
+            }
+
+            m_entries.resize(n);
+            m_erased = 0;
+        }
+
+        std::vector<Entry> m_entries;
+        std::vector< std::unique_ptr<Page> > m_pages;
+        size_t m_size{0};
+        size_t m_erased{0};
+    };
+}
+
+#endif // RCP_PARAMETERTABLE_H
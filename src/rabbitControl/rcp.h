@@ -47,7 +47,10 @@
 #include "parameterfactory.h"
 
 #include "stringstreamwriter.h"
+#include "bufferwriter.h"
+#include "bufferreader.h"
 
+#include "parameterpool.h"
 #include "parametermanager.h"
 #include "parameterserver.h"
 
@@ -36,7 +36,11 @@
 #define SERVERTRANSPORTER_H
 
 #include <map>
+#include <vector>
 #include <istream>
+#include <sstream>
+
+#include "sharedbuffer.h"
 
 namespace rcp {
 
@@ -45,7 +49,19 @@ namespace rcp {
     class ServerTransporterReceiver
     {
     public:
-        virtual void received(std::istream& data, ServerTransporter& transporter, void* id) = 0;
+        // data is a view into the transporters receive buffer
+        // it is only valid during this call
+        virtual void received(const char* data, size_t size, ServerTransporter& transporter, void* id) = 0;
+
+        // convenience for stream based transporters
+        void received(std::istream& data, ServerTransporter& transporter, void* id) {
+            SharedBufferPtr buffer = SharedBuffer::create(data);
+            received(buffer->data(), buffer->size(), transporter, id);
+        }
+
+        // client connection state
+        virtual void connected(ServerTransporter& /*transporter*/, void* /*id*/) {}
+        virtual void disconnected(ServerTransporter& /*transporter*/, void* /*id*/) {}
     };
 
 
@@ -58,24 +74,74 @@ namespace rcp {
         virtual void sendToOne(std::istream& data, void* id) = 0;
         virtual void sendToAll(std::istream& data, void* excludeId) = 0;
 
+        // send data serialized once into a shared buffer
+        // transporters should override these to share the buffer with all connections
+        // the default implementation falls back to the stream interface
+        virtual void sendToOne(const SharedBufferPtr& data, void* id) {
+            std::istringstream stream(std::string(data->data(), data->size()));
+            sendToOne(stream, id);
+        }
+        virtual void sendToAll(const SharedBufferPtr& data, void* excludeId) {
+            std::istringstream stream(std::string(data->data(), data->size()));
+            sendToAll(stream, excludeId);
+        }
+        // send to a set of clients, transporters should frame the data once
+        virtual void sendToMany(const SharedBufferPtr& data, const std::vector<void*>& ids) {
+            for (void* id : ids) {
+                sendToOne(data, id);
+            }
+        }
+
         virtual int getConnectionCount() = 0;
 
         //
-        void addReceivedCb(ServerTransporterReceiver* c, void(ServerTransporterReceiver::* func)(std::istream&, ServerTransporter&, void*)) {
+        void addReceivedCb(ServerTransporterReceiver* c, void(ServerTransporterReceiver::* func)(const char*, size_t, ServerTransporter&, void*)) {
             receive_cb[c] = func;
         }
         void removeReceivedCb(ServerTransporterReceiver* c) {
             receive_cb.erase(c);
         }
 
+        void addConnectedCb(ServerTransporterReceiver* c, void(ServerTransporterReceiver::* func)(ServerTransporter&, void*)) {
+            connected_cb[c] = func;
+        }
+        void removeConnectedCb(ServerTransporterReceiver* c) {
+            connected_cb.erase(c);
+        }
+
+        void addDisconnectedCb(ServerTransporterReceiver* c, void(ServerTransporterReceiver::* func)(ServerTransporter&, void*)) {
+            disconnected_cb[c] = func;
+        }
+        void removeDisconnectedCb(ServerTransporterReceiver* c) {
+            disconnected_cb.erase(c);
+        }
+
     protected:
-        void _received(std::istream& in, void* client) {
+        void _received(const char* data, size_t size, void* client) {
             for (const auto& kv : receive_cb) {
-                (kv.first->*kv.second)(in, *this, client);
+                (kv.first->*kv.second)(data, size, *this, client);
+            }
+        }
+
+        void _received(std::istream& in, void* client) {
+            SharedBufferPtr buffer = SharedBuffer::create(in);
+            _received(buffer->data(), buffer->size(), client);
+        }
+
+        void _connected(void* client) {
+            for (const auto& kv : connected_cb) {
+                (kv.first->*kv.second)(*this, client);
+            }
+        }
+        void _disconnected(void* client) {
+            for (const auto& kv : disconnected_cb) {
+                (kv.first->*kv.second)(*this, client);
             }
         }
 
-        std::map<ServerTransporterReceiver*, void(ServerTransporterReceiver::*)(std::istream&, ServerTransporter&, void*)> receive_cb;
+        std::map<ServerTransporterReceiver*, void(ServerTransporterReceiver::*)(const char*, size_t, ServerTransporter&, void*)> receive_cb;
+        std::map<ServerTransporterReceiver*, void(ServerTransporterReceiver::*)(ServerTransporter&, void*)> connected_cb;
+        std::map<ServerTransporterReceiver*, void(ServerTransporterReceiver::*)(ServerTransporter&, void*)> disconnected_cb;
     };
 }
 
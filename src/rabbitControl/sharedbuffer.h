@@ -0,0 +1,104 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_SHAREDBUFFER_H
+#define RCP_SHAREDBUFFER_H
+
+#include <memory>
+#include <string>
+#include <istream>
+
+namespace rcp {
+
+    class SharedBuffer;
+    typedef std::shared_ptr<const SharedBuffer> SharedBufferPtr;
+
+    /*
+     * SharedBuffer holds serialized data.
+     * it is immutable once created and can be shared by all
+     * transporters and connections without copying the data again.
+    */
+    class SharedBuffer
+    {
+    public:
+        static SharedBufferPtr create(std::string&& data) {
+            return std::make_shared<const SharedBuffer>(std::move(data));
+        }
+
+        static SharedBufferPtr create(const char* data, size_t size) {
+            return std::make_shared<const SharedBuffer>(std::string(data, size));
+        }
+
+        // a single updatevalue packet of parameter valueId.
+        // transporters may replace a pending buffer with a newer one of the same id
+        static SharedBufferPtr create(const char* data, size_t size, short valueId) {
+            return std::make_shared<const SharedBuffer>(std::string(data, size), valueId);
+        }
+
+        static SharedBufferPtr create(std::istream& data) {
+
+            data.clear();
+            data.seekg (0, data.end);
+            std::streamoff length = data.tellg();
+            data.seekg (0, data.beg);
+
+            if (length <= 0) {
+                return create(std::string());
+            }
+
+            std::string buffer(static_cast<size_t>(length), '\0');
+            data.read(&buffer[0], length);
+
+            return create(std::move(buffer));
+        }
+
+        SharedBuffer(std::string&& data, short valueId = 0) :
+            m_data(std::move(data))
+          , m_valueId(valueId)
+        {}
+
+        const char* data() const { return m_data.data(); }
+        size_t size() const { return m_data.size(); }
+        bool empty() const { return m_data.empty(); }
+
+        // 0 if not a single updatevalue packet
+        short getValueId() const { return m_valueId; }
+
+    private:
+        const std::string m_data;
+        const short m_valueId;
+    };
+}
+
+#endif // RCP_SHAREDBUFFER_H
@@ -42,22 +42,40 @@ namespace rcp {
 
     //---------------------------------------------------
     // read strings from stream
-    std::string readTinyString(std::istream& is) {
+    std::string readTinyString(BufferReader& is) {
 
         char size = 0;
         return readStringFromStream(is, size);
     }
 
-    std::string readShortString(std::istream& is) {
+    std::string readShortString(BufferReader& is) {
 
         uint16_t size = 0;
         return readStringFromStream(is, size);
     }
 
-    std::string readLongString(std::istream& is) {
+    std::string readLongString(BufferReader& is) {
 
         uint32_t size = 0;
         return readStringFromStream(is, size);
     }
 
+    bool readTinyString(BufferReader& is, std::string& dest) {
+
+        char size = 0;
+        return readStringFromStream(is, size, dest);
+    }
+
+    bool readShortString(BufferReader& is, std::string& dest) {
+
+        uint16_t size = 0;
+        return readStringFromStream(is, size, dest);
+    }
+
+    bool readLongString(BufferReader& is, std::string& dest) {
+
+        uint32_t size = 0;
+        return readStringFromStream(is, size, dest);
+    }
+
 }
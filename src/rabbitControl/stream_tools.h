@@ -35,11 +35,11 @@
 #ifndef STREAMTOOLS_H
 #define STREAMTOOLS_H
 
-#include <istream>
 #include <ostream>
 #include <string>
 #include <vector>
 
+#include "bufferreader.h"
 #include "color.h"
 #include "ip.h"
 #include "range.h"
@@ -92,9 +92,10 @@ namespace rcp {
     // read from stream
 
     template <typename T>
-    T readFromStream(std::istream& is, const T& i) {
+    T readFromStream(BufferReader& is, const T& i) {
 
-        T value;
+        // zero if the buffer ends early
+        T value{};
         is.read(reinterpret_cast<char *>(&value), sizeof(T));
 
 #if BYTE_ORDER == LITTLE_ENDIAN
@@ -104,13 +105,13 @@ namespace rcp {
         return value;
     }
 
-    std::string readFromStream(std::istream& is, const std::string& i);    
+    std::string readFromStream(BufferReader& is, const std::string& i);    
 
 
 
     template <typename T,
               typename = std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, T>>
-    std::string readStringFromStream(std::istream& is, T s) {
+    std::string readStringFromStream(BufferReader& is, T s) {
         T size;
         is.read(reinterpret_cast<char *>(&size), sizeof(size));
 
@@ -118,18 +119,51 @@ namespace rcp {
         size = swap_endian(size);
 #endif
 
-        // read to buffer
-		std::vector<char> buffer( size );
-		is.read(buffer.data(), size);
+        // construct string directly from the buffer
+        const char* data = is.skip(size);
+        if (data == nullptr) {
+            return std::string();
+        }
+
+        return std::string(data, size);
+    }
+
+    // read a string into dest, reusing its memory
+    // returns true if dest changed
+    template <typename T,
+              typename = std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, T>>
+    bool readStringFromStream(BufferReader& is, T s, std::string& dest) {
+        T size;
+        is.read(reinterpret_cast<char *>(&size), sizeof(size));
+
+#if BYTE_ORDER == LITTLE_ENDIAN
+        size = swap_endian(size);
+#endif
+
+        const char* data = is.skip(size);
+        if (data == nullptr) {
+            return false;
+        }
+
+        if (dest.size() == static_cast<size_t>(size) &&
+                dest.compare(0, dest.size(), data, size) == 0) {
+            return false;
+        }
 
-		return std::string(buffer.data(), size);
+        dest.assign(data, size);
+        return true;
     }
 
 
     // read strings from stream
-    std::string readTinyString(std::istream& is);
-    std::string readShortString(std::istream& is);
-    std::string readLongString(std::istream& is);
+    std::string readTinyString(BufferReader& is);
+    std::string readShortString(BufferReader& is);
+    std::string readLongString(BufferReader& is);
+
+    // read strings from stream into dest, returns true if dest changed
+    bool readTinyString(BufferReader& is, std::string& dest);
+    bool readShortString(BufferReader& is, std::string& dest);
+    bool readLongString(BufferReader& is, std::string& dest);
 
     template <typename T>
     std::ostream& operator<<(std::ostream& out, const Range<T>& v) {
@@ -0,0 +1,177 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#include "stringpool.h"
+
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace rcp {
+
+    /*
+     * StringTable owns the entries of a StringPool.
+     * it is deleted with the pool or, if handles outlive the pool,
+     * with the last entry.
+    */
+    class StringTable
+    {
+    public:
+        InternedString intern(const std::string& str)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto it = m_strings.find(str);
+            if (it == m_strings.end()) {
+                it = m_strings.emplace(std::piecewise_construct,
+                                       std::forward_as_tuple(str),
+                                       std::forward_as_tuple(this, 0)).first;
+            }
+
+            // revives an entry whose last handle is being released
+            it->second.count.fetch_add(1, std::memory_order_relaxed);
+
+            return InternedString(&*it);
+        }
+
+        size_t size()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_strings.size();
+        }
+
+        // drops the last handle of entry
+        void release(InternedString::Entry* entry)
+        {
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                // count only reaches 0 with the lock held
+                if (entry->second.count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    m_strings.erase(m_strings.find(entry->first));
+                    last = m_released && m_strings.empty();
+                }
+            }
+
+            if (last) {
+                delete this;
+            }
+        }
+
+        // called by the pool destructor
+        void releasePool()
+        {
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_released = true;
+                last = m_strings.empty();
+            }
+
+            if (last) {
+                delete this;
+            }
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::unordered_map<std::string, InternedString::Refs> m_strings;
+        bool m_released{false};
+    };
+
+
+    InternedString::InternedString(const std::string& str) :
+        m_entry(str.empty() ? nullptr : new Entry(std::piecewise_construct,
+                                                  std::forward_as_tuple(str),
+                                                  std::forward_as_tuple(nullptr, 1)))
+    {
+    }
+
+    const std::string& InternedString::emptyString()
+    {
+        static const std::string empty;
+        return empty;
+    }
+
+    void InternedString::release(Entry* entry)
+    {
+        Refs& refs = entry->second;
+
+        if (!refs.table) {
+            // not pooled, never revived
+            if (refs.count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete entry;
+            }
+            return;
+        }
+
+        // not the last handle, no need to lock
+        size_t count = refs.count.load(std::memory_order_relaxed);
+        while (count > 1) {
+            if (refs.count.compare_exchange_weak(count, count - 1,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+                return;
+            }
+        }
+
+        refs.table->release(entry);
+    }
+
+
+    StringPool::StringPool() :
+        m_table(new StringTable())
+    {
+    }
+
+    StringPool::~StringPool()
+    {
+        m_table->releasePool();
+    }
+
+    InternedString StringPool::intern(const std::string& str)
+    {
+        if (str.empty()) {
+            return InternedString();
+        }
+
+        return m_table->intern(str);
+    }
+
+    size_t StringPool::size() const
+    {
+        return m_table->size();
+    }
+}
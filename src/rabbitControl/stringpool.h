@@ -0,0 +1,164 @@
+/*
+********************************************************************
+* rabbitcontrol cpp
+*
+* written by: Ingo Randolf - 2018
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* Permission is hereby granted, free of charge, to any person
+* obtaining a copy of this software and associated documentation
+* files (the "Software"), to deal in the Software without
+* restriction, including without limitation the rights to use,
+* copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following
+* conditions:
+*
+* The above copyright notice and this permission notice shall be
+* included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+* OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+* NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+* HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*********************************************************************
+*/
+
+#ifndef RCP_STRINGPOOL_H
+#define RCP_STRINGPOOL_H
+
+#include <string>
+#include <atomic>
+#include <utility>
+
+namespace rcp {
+
+    class StringTable;
+
+    /*
+     * InternedString is a handle to an immutable string.
+     * handles from the same StringPool point to the same table entry
+     * and compare by pointer.
+     * a default constructed handle is the empty string.
+    */
+    class InternedString
+    {
+    public:
+        InternedString() :
+            m_entry(nullptr)
+        {}
+
+        // not pooled, owns a copy of str
+        explicit InternedString(const std::string& str);
+
+        InternedString(const InternedString& other) :
+            m_entry(other.m_entry)
+        {
+            if (m_entry) {
+                m_entry->second.count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        InternedString(InternedString&& other) :
+            m_entry(other.m_entry)
+        {
+            other.m_entry = nullptr;
+        }
+
+        ~InternedString() {
+            if (m_entry) {
+                release(m_entry);
+            }
+        }
+
+        InternedString& operator=(const InternedString& other) {
+            InternedString copy(other);
+            std::swap(m_entry, copy.m_entry);
+            return *this;
+        }
+
+        InternedString& operator=(InternedString&& other) {
+            std::swap(m_entry, other.m_entry);
+            return *this;
+        }
+
+        const std::string& str() const { return m_entry ? m_entry->first : emptyString(); }
+        operator const std::string&() const { return str(); }
+
+        bool empty() const { return m_entry == nullptr; }
+
+        bool operator==(const InternedString& other) const {
+            return m_entry == other.m_entry || str() == other.str();
+        }
+        bool operator!=(const InternedString& other) const { return !(*this == other); }
+        bool operator==(const std::string& other) const { return str() == other; }
+        bool operator!=(const std::string& other) const { return str() != other; }
+
+        bool operator<(const InternedString& other) const { return str() < other.str(); }
+        bool operator<(const std::string& other) const { return str() < other; }
+        friend bool operator<(const std::string& a, const InternedString& b) { return a < b.str(); }
+
+    private:
+        friend class StringTable;
+
+        // handle count of a string, table is nullptr if not pooled
+        struct Refs {
+            Refs(StringTable* t, size_t c) :
+                count(c)
+              , table(t)
+            {}
+
+            std::atomic<size_t> count;
+            StringTable* table;
+        };
+
+        // the string is the key of the table node, no extra copy
+        typedef std::pair<const std::string, Refs> Entry;
+
+        // takes over one counted reference
+        explicit InternedString(Entry* entry) :
+            m_entry(entry)
+        {}
+
+        static const std::string& emptyString();
+        static void release(Entry* entry);
+
+        Entry* m_entry;
+    };
+
+
+    /*
+     * StringPool keeps one copy of each string in use.
+     * a string is removed once its last handle is gone,
+     * handles may outlive the pool.
+     * interning is thread-safe.
+    */
+    class StringPool
+    {
+    public:
+        StringPool();
+        ~StringPool();
+
+        StringPool(const StringPool&) = delete;
+        StringPool& operator=(const StringPool&) = delete;
+
+        // returns the shared handle for str
+        InternedString intern(const std::string& str);
+
+        // number of distinct strings in use
+        size_t size() const;
+
+    private:
+        StringTable* m_table;
+    };
+}
+
+#endif // RCP_STRINGPOOL_H
@@ -38,6 +38,7 @@
 #include <sstream>
 
 #include "writeable.h"
+#include "sharedbuffer.h"
 
 namespace rcp {
 
@@ -76,6 +77,10 @@ namespace rcp {
             return buffer;
         }
 
+        SharedBufferPtr getSharedBuffer() {
+            return SharedBuffer::create(buffer.str());
+        }
+
         void dump() {
             size_t len = buffer.str().size();
             char* data = new char[len];
@@ -58,11 +58,11 @@ namespace rcp {
         {}
 
         TypeDefinition(IParameter& param) :
-            obj(std::make_shared<Value>(param))
+            obj(make_pooled<Value>(param))
         {}
 
         TypeDefinition(const std::string& d, IParameter& param) :
-            obj(std::make_shared<Value>(d, param))
+            obj(make_pooled<Value>(d, param))
         {}
 
         //------------------------------------
@@ -81,7 +81,7 @@ namespace rcp {
 
         //------------------------------------
         // implement optionparser
-        void parseOptions(std::istream& is) {
+        void parseOptions(BufferReader& is) {
 
             while (!is.eof()) {
 
@@ -109,7 +109,7 @@ namespace rcp {
                 case CUSTOMTYPE_OPTIONS_UUID: {
 
                     char uuid[16];
-                    is.get(uuid, 16);
+                    is.read(uuid, 16);
                     CHECK_STREAM
 
                     obj->hasUuid = true;
@@ -121,19 +121,11 @@ namespace rcp {
                     uint32_t data_length = readFromStream(is, data_length);
                     CHECK_STREAM
 
-                    char* data = new char[data_length];
-                    if (data)
-                    {
-                        is.get(data, static_cast<std::streamsize>(data_length));
-                        CHECK_STREAM
-
-                        //set
-                        obj->config.clear();
-                        obj->config.resize(data_length);
-                        memcpy(&obj->config[0], &data[0], data_length);
+                    const char* data = is.skip(data_length);
+                    CHECK_STREAM
 
-                        delete[] data;
-                    }
+                    //set
+                    obj->config.assign(data, data + data_length);
 
                     break;
                 }
@@ -148,8 +140,9 @@ namespace rcp {
         }
 
 
-        virtual T readValue(std::istream& is) {
-            T value = readFromStream(is, value);
+        virtual T readValue(BufferReader& is) {
+            T value{};
+            value = readFromStream(is, value);
             return value;
         }
 
@@ -59,11 +59,11 @@ namespace rcp {
         {}
 
         TypeDefinition(IParameter& param) :
-            obj(std::make_shared<Value>(param))
+            obj(make_pooled<Value>(param))
         {}
 
         TypeDefinition(const T& defaultValue, IParameter& param) :
-            obj(std::make_shared<Value>(defaultValue, param))
+            obj(make_pooled<Value>(defaultValue, param))
         {}
 
         //------------------------------------
@@ -109,7 +109,7 @@ namespace rcp {
 
         //------------------------------------
         // implement optionparser
-        void parseOptions(std::istream& is) {
+        void parseOptions(BufferReader& is) {
 
             while (!is.eof()) {
 
@@ -144,8 +144,9 @@ namespace rcp {
             return obj->defaultValueChanged;
         }
 
-        virtual T readValue(std::istream& is) {
-            T value = readFromStream(is, value);
+        virtual T readValue(BufferReader& is) {
+            T value{};
+            value = readFromStream(is, value);
             return value;
         }
 
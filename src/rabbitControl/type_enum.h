@@ -59,10 +59,10 @@ namespace rcp {
         {}
 
         TypeDefinition(IParameter& param) :
-            obj(std::make_shared<Value>(param))
+            obj(make_pooled<Value>(param))
         {}
         TypeDefinition(const std::string& d, IParameter& param) :
-            obj(std::make_shared<Value>(d, param))
+            obj(make_pooled<Value>(d, param))
         {}
 
         //------------------------------------
@@ -156,7 +156,7 @@ namespace rcp {
 
         //------------------------------------
         // implement optionparser
-        void parseOptions(std::istream& is) {
+        void parseOptions(BufferReader& is) {
 
             while (!is.eof()) {
 
@@ -214,10 +214,14 @@ namespace rcp {
                     || obj->multiselectChanged;
         }
 
-        virtual std::string readValue(std::istream& is) {
+        virtual std::string readValue(BufferReader& is) {
             return readTinyString(is);
         }
 
+        virtual bool readValueInto(BufferReader& is, std::string& value) {
+            return readTinyString(is, value);
+        }
+
         virtual void dump() {
             std::cout << "--- type enum ---\n";
 
@@ -71,7 +71,7 @@ namespace rcp {
 
         //------------------------------------
         // implement optionparser
-        void parseOptions(std::istream& is) {
+        void parseOptions(BufferReader& is) {
             // no options - expect terminator
 
             // read one byte
@@ -60,15 +60,15 @@ namespace rcp {
         {}
 
         TypeDefinition(IParameter& param) :
-            obj(std::make_shared<Value>(param))
+            obj(make_pooled<Value>(param))
         {}
 
         TypeDefinition(const T& dv, IParameter& param) :
-            obj(std::make_shared<Value>(dv, param))
+            obj(make_pooled<Value>(dv, param))
         {}
 
         TypeDefinition(const T& dv, const T& min, const T& max, IParameter& param) :
-            obj(std::make_shared<Value>(dv, min, max, param))
+            obj(make_pooled<Value>(dv, min, max, param))
         {}
 
         //------------------------------------
@@ -87,7 +87,7 @@ namespace rcp {
 
         //------------------------------------
         // implement optionparser
-        void parseOptions(std::istream& is) {
+        void parseOptions(BufferReader& is) {
 
             while (!is.eof()) {
 
@@ -107,7 +107,7 @@ namespace rcp {
                     T def = readFromStream(is, def);
                     CHECK_STREAM
 
-                    obj->hasDefaultValue = true;
+                    obj->has |= OPTION_DEFAULT;
                     obj->defaultValue = def;
                     break;
                 }
@@ -116,7 +116,7 @@ namespace rcp {
                     T min = readFromStream(is, min);
                     CHECK_STREAM
 
-                    obj->hasMinimum = true;
+                    obj->has |= OPTION_MINIMUM;
                     obj->minimum = min;
                     break;
                 }
@@ -125,7 +125,7 @@ namespace rcp {
                     T max = readFromStream(is, max);
                     CHECK_STREAM
 
-                    obj->hasMaximum = true;
+                    obj->has |= OPTION_MAXIMUM;
                     obj->maximum = max;
                     break;
                 }
@@ -134,7 +134,7 @@ namespace rcp {
                     T mult = readFromStream(is, mult);
                     CHECK_STREAM
 
-                    obj->hasMultipleof = true;
+                    obj->has |= OPTION_MULTIPLEOF;
                     obj->multipleof = mult;
                     break;
                 }
@@ -143,7 +143,7 @@ namespace rcp {
                     number_scale_t scale = static_cast<number_scale_t>(is.get());
                     CHECK_STREAM
 
-                    obj->hasScale = true;
+                    obj->has |= OPTION_SCALE;
                     obj->scale = scale;
                     break;
                 }
@@ -152,8 +152,8 @@ namespace rcp {
                     std::string unit = readTinyString(is);
                     CHECK_STREAM
 
-                    obj->hasUnit = true;
-                    obj->unit = unit;
+                    obj->has |= OPTION_UNIT;
+                    obj->unit = obj->parameter.intern(unit);
                     break;
                 }
                 }
@@ -162,8 +162,9 @@ namespace rcp {
         } // parseOptions
 
 
-        virtual T readValue(std::istream& is) {
-            T val = readFromStream(is, val);
+        virtual T readValue(BufferReader& is) {
+            T val{};
+            val = readFromStream(is, val);
             return val;
         }
 
@@ -176,150 +177,145 @@ namespace rcp {
         }
         virtual void setDefault(const T& defaultValue) {
 
-            obj->hasDefaultValue = true;
+            obj->has |= OPTION_DEFAULT;
 
             if (obj->defaultValue == defaultValue) {
                 return;
             }
 
             obj->defaultValue = defaultValue;
-            obj->defaultValueChanged = true;
+            obj->changed |= OPTION_DEFAULT;
             setDirty();
         }
-        virtual bool hasDefault() const { return obj->hasDefaultValue; }
+        virtual bool hasDefault() const { return (obj->has & OPTION_DEFAULT) != 0; }
         virtual void clearDefault() {
-            obj->hasDefaultValue = false;
-            obj->defaultValueChanged = true;
+            obj->has &= ~OPTION_DEFAULT;
+            obj->changed |= OPTION_DEFAULT;
             setDirty();
         }
 
         //------------------------------------
         // implement INumberDefinition
         virtual T getMinimum() const {
-            if (obj->hasMinimum)
+            if (obj->has & OPTION_MINIMUM)
                 return obj->minimum;
             return 0;
         }
         virtual void setMinimum(const T& val) {
 
-            obj->hasMinimum = true;
+            obj->has |= OPTION_MINIMUM;
 
             if (obj->minimum == val) {
                 return;
             }
 
             obj->minimum = val;
-            obj->minimumChanged = true;
+            obj->changed |= OPTION_MINIMUM;
             setDirty();
         }
-        virtual bool hasMinimum() const { return obj->hasMinimum; }
+        virtual bool hasMinimum() const { return (obj->has & OPTION_MINIMUM) != 0; }
         virtual void clearMinimum() {
-            obj->hasMinimum = false;
-            obj->minimumChanged = true;
+            obj->has &= ~OPTION_MINIMUM;
+            obj->changed |= OPTION_MINIMUM;
             setDirty();
         }
 
         virtual T getMaximum() const {
-            if (obj->hasMaximum)
+            if (obj->has & OPTION_MAXIMUM)
                 return obj->maximum;
             return 0;
         }
         virtual void setMaximum(const T& val) {
 
-            obj->hasMaximum = true;
+            obj->has |= OPTION_MAXIMUM;
 
             if (obj->maximum == val) {
                 return;
             }
 
             obj->maximum = val;
-            obj->maximumChanged = true;
+            obj->changed |= OPTION_MAXIMUM;
             setDirty();
         }
-        virtual bool hasMaximum() const { return obj->hasMaximum; }
+        virtual bool hasMaximum() const { return (obj->has & OPTION_MAXIMUM) != 0; }
         virtual void clearMaximum() {
-            obj->hasMaximum = false;
-            obj->maximumChanged = true;
+            obj->has &= ~OPTION_MAXIMUM;
+            obj->changed |= OPTION_MAXIMUM;
             setDirty();
         }
 
         virtual T getMultipleof() const {
-            if (obj->hasMultipleof)
+            if (obj->has & OPTION_MULTIPLEOF)
                 return obj->multipleof;
             return 0;
         }
         virtual void setMultipleof(const T& val) {
 
-            obj->hasMultipleof = true;
+            obj->has |= OPTION_MULTIPLEOF;
 
             if (obj->multipleof == val) {
                 return;
             }
 
             obj->multipleof = val;
-            obj->multipleofChanged = true;
+            obj->changed |= OPTION_MULTIPLEOF;
             setDirty();
         }
-        virtual bool hasMultipleof() const { return obj->hasMultipleof; }
+        virtual bool hasMultipleof() const { return (obj->has & OPTION_MULTIPLEOF) != 0; }
         virtual void clearMultipleof() {
-            obj->hasMultipleof = false;
-            obj->multipleofChanged = true;
+            obj->has &= ~OPTION_MULTIPLEOF;
+            obj->changed |= OPTION_MULTIPLEOF;
             setDirty();
         }
 
         virtual number_scale_t getScale() const {
-            if (obj->hasScale)
+            if (obj->has & OPTION_SCALE)
                 return obj->scale;
             return NUMBER_SCALE_LINEAR;
         }
         virtual void setScale(const number_scale_t& val) {
 
-            obj->hasScale = true;
+            obj->has |= OPTION_SCALE;
 
             if (obj->scale == val) {
                 return;
             }
 
             obj->scale = val;
-            obj->scaleChanged = true;
+            obj->changed |= OPTION_SCALE;
             setDirty();
         }
-        virtual bool hasScale() const { return obj->hasScale; }
+        virtual bool hasScale() const { return (obj->has & OPTION_SCALE) != 0; }
         virtual void clearScale() {
-            obj->hasScale = false;
-            obj->scaleChanged = true;
+            obj->has &= ~OPTION_SCALE;
+            obj->changed |= OPTION_SCALE;
             setDirty();
         }
 
         virtual std::string getUnit() const { return obj->unit; }
         virtual void setUnit(const std::string& val) {
 
-            obj->hasUnit = true;
+            obj->has |= OPTION_UNIT;
 
             if (obj->unit == val) {
                 return;
             }
 
-            obj->unit = val;
-            obj->unitChanged = true;
+            obj->unit = obj->parameter.intern(val);
+            obj->changed |= OPTION_UNIT;
             setDirty();
         }
-        virtual bool hasUnit() const { return obj->hasUnit; }
+        virtual bool hasUnit() const { return (obj->has & OPTION_UNIT) != 0; }
         virtual void clearUnit() {
-            obj->hasUnit = false;
-            obj->unitChanged = true;
+            obj->has &= ~OPTION_UNIT;
+            obj->changed |= OPTION_UNIT;
 
             setDirty();
         }
 
 
         virtual bool anyOptionChanged() const {
-            return obj->defaultValueChanged
-                    || obj->minimumChanged
-                    || obj->maximumChanged
-                    || obj->multipleofChanged
-                    || obj->scaleChanged
-                    || obj->unitChanged;
+            return obj->changed != 0;
         }
 
         virtual void dump() {
@@ -355,64 +351,44 @@ namespace rcp {
             obj->parameter.setDirty();
         }
 
+        // bits of Value::has and Value::changed
+        enum : uint8_t {
+            OPTION_DEFAULT = 1 << 0,
+            OPTION_MINIMUM = 1 << 1,
+            OPTION_MAXIMUM = 1 << 2,
+            OPTION_MULTIPLEOF = 1 << 3,
+            OPTION_SCALE = 1 << 4,
+            OPTION_UNIT = 1 << 5
+        };
+
         class Value {
         public:
             Value(IParameter& param) :
                 datatype(type_id)
-              , hasDefaultValue(false)
-              , defaultValueChanged(false)
+              , has(0)
+              , changed(0)
               , minimum(std::numeric_limits<T>::min())
-              , hasMinimum(false)
-              , minimumChanged(false)
               , maximum(std::numeric_limits<T>::max())
-              , hasMaximum(false)
-              , maximumChanged(false)
-              , hasMultipleof(false)
-              , multipleofChanged(false)
-              , hasScale(false)
-              , scaleChanged(false)
-              , hasUnit(false)
-              , unitChanged(false)
               , parameter(param)
             {}
 
             Value(const T& defaultValue, IParameter& param) :
                 datatype(type_id)
+              , has(OPTION_DEFAULT)
+              , changed(OPTION_DEFAULT)
               , defaultValue(defaultValue)
-              , hasDefaultValue(true)
-              , defaultValueChanged(true)
               , minimum(std::numeric_limits<T>::min())
-              , hasMinimum(false)
-              , minimumChanged(false)
               , maximum(std::numeric_limits<T>::max())
-              , hasMaximum(false)
-              , maximumChanged(false)
-              , hasMultipleof(false)
-              , multipleofChanged(false)
-              , hasScale(false)
-              , scaleChanged(false)
-              , hasUnit(false)
-              , unitChanged(false)
               , parameter(param)
             {}
 
             Value(const T& defaultValue, const T& min, const T& max, IParameter& param) :
                 datatype(type_id)
+              , has(OPTION_DEFAULT | OPTION_MINIMUM | OPTION_MAXIMUM)
+              , changed(OPTION_DEFAULT | OPTION_MINIMUM | OPTION_MAXIMUM)
               , defaultValue(defaultValue)
-              , hasDefaultValue(true)
-              , defaultValueChanged(true)
               , minimum(min)
-              , hasMinimum(true)
-              , minimumChanged(true)
               , maximum(max)
-              , hasMaximum(true)
-              , maximumChanged(true)
-              , hasMultipleof(false)
-              , multipleofChanged(false)
-              , hasScale(false)
-              , scaleChanged(false)
-              , hasUnit(false)
-              , unitChanged(false)
               , parameter(param)
             {}
 
@@ -424,147 +400,121 @@ namespace rcp {
 
                 writeMandatory(out);
 
+                if (!all && changed == 0) {
+                    // nothing to write
+                    return;
+                }
+
                 // write default value
-                if (hasDefaultValue) {
+                if (has & OPTION_DEFAULT) {
 
-                    if (all || defaultValueChanged) {
+                    if (all || (changed & OPTION_DEFAULT)) {
                         out.write(static_cast<char>(NUMBER_OPTIONS_DEFAULT));
                         out.write(defaultValue);
-
-                        if (!all) {
-                            defaultValueChanged = false;
-                        }
                     }
-                } else if (defaultValueChanged) {
+                } else if (changed & OPTION_DEFAULT) {
                     out.write(static_cast<char>(NUMBER_OPTIONS_DEFAULT));
                     out.write(static_cast<T>(0));
-                    defaultValueChanged = false;
+                    changed &= ~OPTION_DEFAULT;
                 }
 
 
                 // minimum
-                if (hasMinimum) {
+                if (has & OPTION_MINIMUM) {
 
-                    if (all || minimumChanged) {
+                    if (all || (changed & OPTION_MINIMUM)) {
                         out.write(static_cast<char>(NUMBER_OPTIONS_MINIMUM));
                         out.write(minimum);
-
-                        if (!all) {
-                            minimumChanged = false;
-                        }
                     }
-                } else if (minimumChanged) {
+                } else if (changed & OPTION_MINIMUM) {
 
                     out.write(static_cast<char>(NUMBER_OPTIONS_MINIMUM));
                     out.write(std::numeric_limits<T>::min());
-                    minimumChanged = false;
+                    changed &= ~OPTION_MINIMUM;
                 }
 
 
                 // maximum
-                if (hasMaximum) {
+                if (has & OPTION_MAXIMUM) {
 
-                    if (all || maximumChanged) {
+                    if (all || (changed & OPTION_MAXIMUM)) {
                         out.write(static_cast<char>(NUMBER_OPTIONS_MAXIMUM));
                         out.write(maximum);
-
-                        if (!all) {
-                            maximumChanged = false;
-                        }
                     }
-                } else if (maximumChanged) {
+                } else if (changed & OPTION_MAXIMUM) {
 
                     out.write(static_cast<char>(NUMBER_OPTIONS_MAXIMUM));
                     out.write(std::numeric_limits<T>::max());
-                    maximumChanged = false;
+                    changed &= ~OPTION_MAXIMUM;
                 }
 
 
                 // multipleof
-                if (hasMultipleof) {
+                if (has & OPTION_MULTIPLEOF) {
 
-                    if (all || multipleofChanged) {
+                    if (all || (changed & OPTION_MULTIPLEOF)) {
                         out.write(static_cast<char>(NUMBER_OPTIONS_MULTIPLEOF));
                         out.write(multipleof);
-
-                        if (!all) {
-                            multipleofChanged = false;
-                        }
                     }
-                } else if (multipleofChanged) {
+                } else if (changed & OPTION_MULTIPLEOF) {
 
                     out.write(static_cast<char>(NUMBER_OPTIONS_MULTIPLEOF));
                     out.write(static_cast<T>(0));
-                    multipleofChanged = false;
+                    changed &= ~OPTION_MULTIPLEOF;
                 }
 
 
                 // scale
-                if (hasScale) {
+                if (has & OPTION_SCALE) {
 
-                    if (all || scaleChanged) {
+                    if (all || (changed & OPTION_SCALE)) {
                         out.write(static_cast<char>(NUMBER_OPTIONS_SCALE));
                         out.write(static_cast<char>(scale));
-
-                        if (!all) {
-                            scaleChanged = false;
-                        }
                     }
-                } else if (scaleChanged) {
+                } else if (changed & OPTION_SCALE) {
 
                     out.write(static_cast<char>(NUMBER_OPTIONS_SCALE));
                     out.write(static_cast<char>(NUMBER_SCALE_LINEAR));
-                    scaleChanged = false;
+                    changed &= ~OPTION_SCALE;
                 }
 
 
                 // unit
-                if (hasUnit) {
+                if (has & OPTION_UNIT) {
 
-                    if (all || unitChanged) {
+                    if (all || (changed & OPTION_UNIT)) {
                         out.write(static_cast<char>(NUMBER_OPTIONS_UNIT));
                         out.writeTinyString(unit);
-
-                        if (!all) {
-                            unitChanged = false;
-                        }
                     }
-                } else if (unitChanged) {
+                } else if (changed & OPTION_UNIT) {
 
                     out.write(static_cast<char>(NUMBER_OPTIONS_UNIT));
                     out.writeTinyString("");
-                    unitChanged = false;
+                    changed &= ~OPTION_UNIT;
+                }
+
+                // a full write keeps other changes for the next update
+                if (!all) {
+                    changed = 0;
                 }
             }
 
             // mandatory
             datatype_t datatype;
 
+            // OPTION_ bits
+            uint8_t has;
+            uint8_t changed;
+
             // options - base
             T defaultValue{0};
-            bool hasDefaultValue;
-            bool defaultValueChanged;
 
             // options - number
             T minimum{0};
-            bool hasMinimum;
-            bool minimumChanged;
-
             T maximum{0};
-            bool hasMaximum;
-            bool maximumChanged;
-
             T multipleof{0};
-            bool hasMultipleof;
-            bool multipleofChanged;
-
             number_scale_t scale{NUMBER_SCALE_LINEAR};
-            bool hasScale;
-            bool scaleChanged;
-
-            std::string unit{""};
-            bool hasUnit;
-            bool unitChanged;
+            InternedString unit;
 
             IParameter& parameter;
         };
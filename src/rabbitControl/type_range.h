@@ -59,11 +59,11 @@ namespace rcp {
         {}
 
         TypeDefinition(IParameter& param) :
-            obj(std::make_shared<Value>(param))
+            obj(make_pooled<Value>(param))
         {}
 
         TypeDefinition(const std::string& d, IParameter& param) :
-            obj(std::make_shared<Value>(d, param))
+            obj(make_pooled<Value>(d, param))
         {}
 
         //------------------------------------
@@ -84,7 +84,7 @@ namespace rcp {
 
         //------------------------------------
         // implement optionparser
-        void parseOptions(std::istream& is) {
+        void parseOptions(BufferReader& is) {
 
             // parse element type options first
             obj->element_type.parseOptions(is);
@@ -126,9 +126,11 @@ namespace rcp {
         }
 
 
-        virtual Range<ElementType> readValue(std::istream& is) {
-            ElementType v1 = readFromStream(is, v1);
-            ElementType v2 = readFromStream(is, v2);
+        virtual Range<ElementType> readValue(BufferReader& is) {
+            ElementType v1{};
+            ElementType v2{};
+            v1 = readFromStream(is, v1);
+            v2 = readFromStream(is, v2);
             return Range<ElementType>(v1, v2);
         }
 
@@ -58,11 +58,11 @@ namespace rcp {
         {}
 
         TypeDefinition(IParameter& param) :
-            obj(std::make_shared<Value>(param))
+            obj(make_pooled<Value>(param))
         {}
 
         TypeDefinition(const std::string& d, IParameter& param) :
-            obj(std::make_shared<Value>(d, param))
+            obj(make_pooled<Value>(d, param))
         {}
 
         //------------------------------------
@@ -81,7 +81,7 @@ namespace rcp {
 
         //------------------------------------
         // implement optionparser
-        void parseOptions(std::istream& is) {
+        void parseOptions(BufferReader& is) {
 
             while (!is.eof()) {
 
@@ -124,10 +124,14 @@ namespace rcp {
                     || obj->regexChanged;
         }
 
-        virtual std::string readValue(std::istream& is) {
+        virtual std::string readValue(BufferReader& is) {
             return readLongString(is);
         }
 
+        virtual bool readValueInto(BufferReader& is, std::string& value) {
+            return readLongString(is, value);
+        }
+
         //------------------------------------
         // implement ITypeDefinition
         virtual datatype_t getDatatype() const { return obj->datatype; }
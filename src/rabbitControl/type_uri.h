@@ -61,11 +61,11 @@ namespace rcp {
         {}
 
         TypeDefinition(IParameter& param) :
-            obj(std::make_shared<Value>(param))
+            obj(make_pooled<Value>(param))
         {}
 
         TypeDefinition(const std::string& d, IParameter& param) :
-            obj(std::make_shared<Value>(d, param))
+            obj(make_pooled<Value>(d, param))
         {}
 
         //------------------------------------
@@ -144,7 +144,7 @@ namespace rcp {
 
         //------------------------------------
         // implement optionparser
-        void parseOptions(std::istream& is) {
+        void parseOptions(BufferReader& is) {
 
             while (!is.eof()) {
 
@@ -201,10 +201,14 @@ namespace rcp {
                     || obj->schemaChanged;
         }
 
-        virtual std::string readValue(std::istream& is) {
+        virtual std::string readValue(BufferReader& is) {
             return readLongString(is);
         }
 
+        virtual bool readValueInto(BufferReader& is, std::string& value) {
+            return readLongString(is, value);
+        }
+
 
         virtual void dump() {
             std::cout << "--- type uri ---\n";
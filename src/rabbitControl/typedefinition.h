@@ -40,6 +40,7 @@
 #include "types.h"
 #include "writeable.h"
 #include "optionparser.h"
+#include "parameterpool.h"
 
 namespace rcp {
 
@@ -65,7 +66,17 @@ namespace rcp {
         virtual bool hasDefault() const = 0;
         virtual void clearDefault() = 0;
 
-        virtual T readValue(std::istream& is) = 0;
+        virtual T readValue(BufferReader& is) = 0;
+
+        // read a value into value, returns true if value changed
+        virtual bool readValueInto(BufferReader& is, T& value) {
+            T v = readValue(is);
+            if (is.eof() || v == value) {
+                return false;
+            }
+            value = std::move(v);
+            return true;
+        }
     };
 
 
@@ -154,8 +154,16 @@ enum string_options_t {
     STRING_OPTIONS_REGULAR_EXPRESSION = 49
 };
 
+// options below INFODATA_OPTIONS_LENGTH_PREFIXED_ are flags without payload
+// unless listed otherwise, older parsers skip these.
+// options from INFODATA_OPTIONS_LENGTH_PREFIXED_ on start with a uint16 byte length,
+// they are only sent to peers that announced support.
 enum infodata_options_t {
-    INFODATA_OPTIONS_APPLICATIONID = 26
+    INFODATA_OPTIONS_APPLICATIONID = 26,
+    INFODATA_OPTIONS_MULTIPACKET = 27, // flag, no payload
+    INFODATA_OPTIONS_SUBSCRIPTIONS = 28, // flag, no payload: server accepts INFODATA_OPTIONS_SUBSCRIBE
+    INFODATA_OPTIONS_LENGTH_PREFIXED_ = 64,
+    INFODATA_OPTIONS_SUBSCRIBE = 64 // uint16 byte length, int16 group ids
 };
 
 enum array_options_t {
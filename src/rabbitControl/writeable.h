@@ -43,10 +43,15 @@
 
 namespace rcp {
 
+    class IParameter;
+
     class Writeable {
     public:
         virtual ~Writeable();
         virtual void write(Writer& out, bool all) = 0;
+
+        // the parameter if this is one, nullptr otherwise
+        virtual IParameter* asParameter() { return nullptr; }
     };
 
     Writer& operator<<(Writer& out, Writeable& Writeable);
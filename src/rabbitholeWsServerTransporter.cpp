@@ -104,12 +104,8 @@ void rabbitholeWsServerTransporter::disconnected()
 
 void rabbitholeWsServerTransporter::received(char* data, size_t size)
 {
-	std::istringstream input_stream(std::string(const_cast<char*>(data), size));
-
-    // call receive callbacks
-    for (const auto& kv : receive_cb) {
-        (kv.first->*kv.second)(input_stream, *this, this);
-    }
+    // call receive callbacks with a view on the payload
+    _received(data, size, this);
 }
 
 //----------------------------------------
@@ -135,21 +131,32 @@ void rabbitholeWsServerTransporter::unbind()
 
 void rabbitholeWsServerTransporter::sendToOne(std::istream& data, void* id)
 {
-    data.seekg (0, data.end);
-    size_t length = data.tellg();
-    data.seekg (0, data.beg);
+    sendToOne(rcp::SharedBuffer::create(data), id);
+}
 
-    char d[length];
-    data.read(d, length);
+void rabbitholeWsServerTransporter::sendToAll(std::istream& data, void* excludeId)
+{
+    sendToOne(data, nullptr);
+}
 
-    rcp::websocketClient::send(d, length);
+void rabbitholeWsServerTransporter::sendToOne(const rcp::SharedBufferPtr& data, void* id)
+{
+    rcp::websocketClient::send(data->data(), data->size());
 }
 
-void rabbitholeWsServerTransporter::sendToAll(std::istream& data, void* excludeId)
+void rabbitholeWsServerTransporter::sendToAll(const rcp::SharedBufferPtr& data, void* excludeId)
 {
     sendToOne(data, nullptr);
 }
 
+void rabbitholeWsServerTransporter::sendToMany(const rcp::SharedBufferPtr& data, const std::vector<void*>& ids)
+{
+    // one connection to rabbithole
+    if (!ids.empty()) {
+        sendToOne(data, nullptr);
+    }
+}
+
 int rabbitholeWsServerTransporter::getConnectionCount()
 {
     return isOpen();
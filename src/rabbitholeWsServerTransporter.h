@@ -69,6 +69,9 @@ public:
     virtual void unbind() override;
     virtual void sendToOne(std::istream& data, void* id) override;
     virtual void sendToAll(std::istream& data, void* excludeId) override;
+    virtual void sendToOne(const rcp::SharedBufferPtr& data, void* id) override;
+    virtual void sendToAll(const rcp::SharedBufferPtr& data, void* excludeId) override;
+    virtual void sendToMany(const rcp::SharedBufferPtr& data, const std::vector<void*>& ids) override;
     virtual int getConnectionCount() override;
 
 private:
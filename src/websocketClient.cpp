@@ -235,7 +235,7 @@ void websocketClient::on_message(connection_hdl /*hdl*/, ssl_client::message_ptr
     }
 }
 
-void websocketClient::send(char* data, size_t size)
+void websocketClient::send(const char* data, size_t size)
 {
 #ifndef RCP_PD_NO_SSL
     if (m_sslCon)
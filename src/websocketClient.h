@@ -94,7 +94,7 @@ public:
     void close();
 
     void on_message(connection_hdl hdl, ssl_client::message_ptr msg);
-    void send(char* data, size_t size);
+    void send(const char* data, size_t size);
 
     // SSL
     context_ptr on_tls_init(websocketpp::connection_hdl);
@@ -38,7 +38,12 @@
 #include "rabbitControl/servertransporter.h"
 
 #include <iostream>
+#include <algorithm>
+#include <vector>
 #include <set>
+#include <list>
+#include <map>
+#include <unordered_map>
 
 #include <websocketpp/config/asio_no_tls.hpp>
 #include <websocketpp/server.hpp>
@@ -59,6 +64,7 @@ using websocketpp::lib::condition_variable;
 
 // pull out the type of messages sent by our config
 typedef server::message_ptr message_ptr;
+typedef websocketpp::config::asio::message_type message_type;
 
 enum action_type {
     SUBSCRIBE,
@@ -67,13 +73,14 @@ enum action_type {
 };
 
 struct action {
-    action(action_type t, connection_hdl h) : type(t), hdl(h) {}
+    action(action_type t, connection_hdl h, void* i) : type(t), hdl(h), id(i) {}
     action(action_type t, connection_hdl h, server::message_ptr m)
       : type(t), hdl(h), msg(m) {}
 
     action_type type;
     websocketpp::connection_hdl hdl;
     server::message_ptr msg;
+    void* id{nullptr};
 };
 
 
@@ -164,11 +171,29 @@ public:
 
         m_server.stop_listening();
         m_server.stop();
-        m_connections.clear();
+
+        {
+            lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
+            m_connections.clear();
+        }
+
+        lock_guard<websocketpp::lib::mutex> guard(m_queue_lock);
+        m_queues.clear();
+        m_flushScheduled = false;
     }
 
 
     virtual void sendToOne(std::istream& data, void* id)
+    {
+        sendToOne(rcp::SharedBuffer::create(data), id);
+    }
+
+    virtual void sendToAll(std::istream& data, void* excludeId)
+    {
+        sendToAll(rcp::SharedBuffer::create(data), excludeId);
+    }
+
+    virtual void sendToOne(const rcp::SharedBufferPtr& data, void* id)
     {
         if (!m_server.is_listening()) {
             return;
@@ -178,19 +203,17 @@ public:
             return;
         }
 
-        data.seekg (0, data.end);
-        size_t length = data.tellg();
-        data.seekg (0, data.beg);
+        message_ptr msg = prepareMessage(data);
 
-        char d[length];
-        data.read(d, length);
+        lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
+        lock_guard<websocketpp::lib::mutex> queue_guard(m_queue_lock);
 
         for (auto& conn : m_connections)
         {
             if (auto p = conn.lock())
             {
                 if (id == p.get()) {
-                    m_server.send(conn, d, length, websocketpp::frame::opcode::value::binary);
+                    send(conn, p.get(), msg, data->getValueId());
                 }
             }
             else
@@ -200,18 +223,17 @@ public:
         }
     }
 
-    virtual void sendToAll(std::istream& data, void* excludeId) {
-
+    virtual void sendToAll(const rcp::SharedBufferPtr& data, void* excludeId)
+    {
         if (!m_server.is_listening()) {
             return;
         }
 
-        data.seekg (0, data.end);
-        size_t length = data.tellg();
-        data.seekg (0, data.beg);
+        // frame the data once, all connections share the same message
+        message_ptr msg = prepareMessage(data);
 
-        char d[length];
-        data.read(d, length);
+        lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
+        lock_guard<websocketpp::lib::mutex> queue_guard(m_queue_lock);
 
         for (auto& conn : m_connections)
         {
@@ -221,22 +243,70 @@ public:
                 {
                     continue;
                 }
-                m_server.send(conn, d, length, websocketpp::frame::opcode::value::binary);
+                send(conn, p.get(), msg, data->getValueId());
+            }
+        }
+    }
+
+    virtual void sendToMany(const rcp::SharedBufferPtr& data, const std::vector<void*>& ids)
+    {
+        if (!m_server.is_listening() ||
+            ids.empty())
+        {
+            return;
+        }
+
+        std::vector<void*> receivers(ids);
+        std::sort(receivers.begin(), receivers.end());
+
+        // frame the data once for all receivers
+        message_ptr msg = prepareMessage(data);
+
+        lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
+        lock_guard<websocketpp::lib::mutex> queue_guard(m_queue_lock);
+
+        for (auto& conn : m_connections)
+        {
+            if (auto p = conn.lock())
+            {
+                if (std::binary_search(receivers.begin(), receivers.end(), (void*)p.get())) {
+                    send(conn, p.get(), msg, data->getValueId());
+                }
             }
         }
     }
 
     virtual int getConnectionCount()
     {
+        lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
         return int(m_connections.size());
     }
 
+    // messages to a connection with more buffered bytes are queued.
+    // queued values of a parameter are replaced by newer ones
+    void setMaxBufferedAmount(size_t amount) {
+        m_maxBufferedAmount = amount;
+    }
+    size_t getMaxBufferedAmount() const {
+        return m_maxBufferedAmount;
+    }
+
+    // a connection with more queued bytes gets no new messages
+    // until the queue drains, queued values are still replaced.
+    // the connection is not closed
+    void setMaxQueuedAmount(size_t amount) {
+        m_maxQueuedAmount = amount;
+    }
+    size_t getMaxQueuedAmount() const {
+        return m_maxQueuedAmount;
+    }
+
     // websocket methods
     void on_open(connection_hdl hdl)
     {
         {
             lock_guard<websocketpp::lib::mutex> guard(m_action_lock);
-            m_actions.push(action(SUBSCRIBE,hdl));
+            m_actions.push(action(SUBSCRIBE,hdl,m_server.get_con_from_hdl(hdl).get()));
         }
         m_action_cond.notify_one();
     }
@@ -245,7 +315,7 @@ public:
     {
         {
             lock_guard<websocketpp::lib::mutex> guard(m_action_lock);
-            m_actions.push(action(UNSUBSCRIBE,hdl));
+            m_actions.push(action(UNSUBSCRIBE,hdl,m_server.get_con_from_hdl(hdl).get()));
         }
         m_action_cond.notify_one();
     }
@@ -282,32 +352,37 @@ public:
             lock.unlock();
 
             //
+            // the connection lock only guards m_connections,
+            // callbacks may send and must run without it
             if (a.type == SUBSCRIBE)
             {
-                lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
-                m_connections.insert(a.hdl);
+                {
+                    lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
+                    m_connections.insert(a.hdl);
+                }
+                _connected(a.id);
             }
             else if (a.type == UNSUBSCRIBE)
             {
-                lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
-                m_connections.erase(a.hdl);
+                {
+                    lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
+                    m_connections.erase(a.hdl);
+
+                    lock_guard<websocketpp::lib::mutex> queue_guard(m_queue_lock);
+                    m_queues.erase(a.id);
+                }
+                _disconnected(a.id);
             }
             else if (a.type == MESSAGE)
             {
-                lock_guard<websocketpp::lib::mutex> guard(m_connection_lock);
-
                 if (a.msg->get_opcode() == websocketpp::frame::opcode::value::binary)
                 {
-                    auto data = a.msg->get_raw_payload();
-					
-					std::istringstream input_stream(std::string(const_cast<char*>(data.data()), data.size()));
-					
+                    const std::string& data = a.msg->get_raw_payload();
+
                     if (auto ptr = a.hdl.lock())
                     {
-                        // call receive callbacks
-                        for (const auto& kv : receive_cb) {
-                            (kv.first->*kv.second)(input_stream, *this, ptr.get());
-                        }
+                        // call receive callbacks with a view on the payload
+                        _received(data.data(), data.size(), ptr.get());
                     }
                 }
                 else
@@ -326,6 +401,174 @@ public:
 private:
     typedef std::set<connection_hdl,std::owner_less<connection_hdl> > con_list;
 
+    struct PendingMessage {
+        message_ptr msg;
+        short valueId;
+    };
+
+    // messages held back while a connection is congested
+    struct OutboundQueue {
+        connection_hdl hdl;
+        std::list<PendingMessage> messages;
+        // pending updatevalue messages by parameter id
+        std::unordered_map<short, std::list<PendingMessage>::iterator> values;
+        size_t size{0};
+        // over the queue limit, new messages are dropped
+        bool dropping{false};
+    };
+
+    // send or queue a message, call with queue lock held
+    void send(connection_hdl hdl, void* id, const message_ptr& msg, short valueId)
+    {
+        websocketpp::lib::error_code ec;
+        server::connection_ptr con = m_server.get_con_from_hdl(hdl, ec);
+        if (ec) {
+            return;
+        }
+
+        auto it = m_queues.find(id);
+        if (it == m_queues.end())
+        {
+            if (con->get_buffered_amount() < m_maxBufferedAmount)
+            {
+                con->send(msg);
+                return;
+            }
+
+            it = m_queues.insert(std::make_pair(id, OutboundQueue())).first;
+            it->second.hdl = hdl;
+        }
+
+        OutboundQueue& queue = it->second;
+        size_t size = msg->get_payload().size();
+
+        auto value = valueId != 0 ? queue.values.find(valueId) : queue.values.end();
+        if (value != queue.values.end())
+        {
+            // latest value wins, keep position
+            queue.size -= value->second->msg->get_payload().size();
+            value->second->msg = msg;
+        }
+        else if (queue.size + size > m_maxQueuedAmount)
+        {
+            // client does not keep up, keep the connection
+            // and drop what does not replace a queued value
+            if (!queue.dropping) {
+                queue.dropping = true;
+                ofLogWarning() << "websocket client congested, dropping messages";
+            }
+            scheduleFlush();
+            return;
+        }
+        else
+        {
+            queue.messages.push_back(PendingMessage{msg, valueId});
+
+            if (valueId != 0) {
+                queue.values[valueId] = std::prev(queue.messages.end());
+            } else {
+                // keep order, later values must not pass this message
+                queue.values.clear();
+            }
+        }
+
+        queue.size += size;
+
+        if (flush(queue, con)) {
+            m_queues.erase(it);
+            return;
+        }
+
+        scheduleFlush();
+    }
+
+    // send queued messages while the connection is not congested.
+    // returns true if the queue is empty
+    bool flush(OutboundQueue& queue, server::connection_ptr& con)
+    {
+        while (!queue.messages.empty() &&
+               con->get_buffered_amount() < m_maxBufferedAmount)
+        {
+            PendingMessage& pending = queue.messages.front();
+
+            if (pending.valueId != 0)
+            {
+                auto value = queue.values.find(pending.valueId);
+                if (value != queue.values.end() &&
+                    value->second == queue.messages.begin())
+                {
+                    queue.values.erase(value);
+                }
+            }
+
+            queue.size -= pending.msg->get_payload().size();
+            con->send(pending.msg);
+            queue.messages.pop_front();
+        }
+
+        return queue.messages.empty();
+    }
+
+    // call with queue lock held
+    void scheduleFlush()
+    {
+        if (m_flushScheduled) {
+            return;
+        }
+
+        m_flushScheduled = true;
+        m_server.set_timer(10, std::bind(&websocketServerTransporter::on_flush_timer, this, ::_1));
+    }
+
+    void on_flush_timer(websocketpp::lib::error_code const & ec)
+    {
+        lock_guard<websocketpp::lib::mutex> guard(m_queue_lock);
+
+        m_flushScheduled = false;
+
+        if (ec) {
+            return;
+        }
+
+        for (auto it = m_queues.begin(); it != m_queues.end(); )
+        {
+            websocketpp::lib::error_code con_ec;
+            server::connection_ptr con = m_server.get_con_from_hdl(it->second.hdl, con_ec);
+
+            if (con_ec || flush(it->second, con)) {
+                it = m_queues.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (!m_queues.empty()) {
+            scheduleFlush();
+        }
+    }
+
+    // create a prepared binary message.
+    // server frames are neither masked nor compressed,
+    // so the same message can be queued on every connection
+    message_ptr prepareMessage(const rcp::SharedBufferPtr& data)
+    {
+        message_ptr msg = websocketpp::lib::make_shared<message_type>(message_type::con_msg_man_ptr(),
+                                                                      websocketpp::frame::opcode::value::binary,
+                                                                      data->size());
+
+        websocketpp::frame::basic_header h(websocketpp::frame::opcode::value::binary,
+                                           data->size(),
+                                           true,
+                                           false);
+        websocketpp::frame::extended_header e(data->size());
+
+        msg->set_header(websocketpp::frame::prepare_header(h, e));
+        msg->append_payload(data->data(), data->size());
+        msg->set_prepared(true);
+
+        return msg;
+    }
+
     server m_server;
     con_list m_connections;
     std::queue<action> m_actions;
@@ -334,6 +577,13 @@ private:
     websocketpp::lib::mutex m_connection_lock;
     condition_variable m_action_cond;
 
+    // outbound queues of congested connections
+    std::map<void*, OutboundQueue> m_queues;
+    websocketpp::lib::mutex m_queue_lock;
+    bool m_flushScheduled{false};
+    size_t m_maxBufferedAmount{256 * 1024};
+    size_t m_maxQueuedAmount{4 * 1024 * 1024};
+
     // service thread
     websocketpp::lib::thread *ws_thread{nullptr};
     std::atomic_bool m_run{false};